@@ -0,0 +1,408 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Bytecode/BytecodeWriter.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/ControlFlow/IR/ControlFlow.h>
+#include <mlir/Dialect/DLTI/DLTI.h>
+#include <mlir/Dialect/LLVMIR/LLVMDialect.h>
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/OwningOpRef.h>
+#include <mlir/Parser/Parser.h>
+#include <mlir/Pass/PassManager.h>
+#include <mlir/Pass/PassRegistry.h>
+#include <mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h>
+#include <mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h>
+#include <mlir/Target/LLVMIR/Export.h>
+
+#include <llvm/ADT/StringSet.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/TargetParser/Host.h>
+
+#include <pylir/CodeGen/CodeGen.hpp>
+#include <pylir/LLVM/PlaceStatepoints.hpp>
+#include <pylir/LLVM/PylirGC.hpp>
+#include <pylir/Lexer/Lexer.hpp>
+#include <pylir/Optimizer/ExternalModels/ExternalModels.hpp>
+#include <pylir/Optimizer/Linker/Linker.hpp>
+#include <pylir/Optimizer/Optimizer.hpp>
+#include <pylir/Optimizer/PylirHIR/IR/PylirHIRDialect.hpp>
+#include <pylir/Optimizer/PylirMem/IR/PylirMemDialect.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyDialect.hpp>
+#include <pylir/Parser/Parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string readFile(llvm::StringRef path) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+      llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    llvm::report_fatal_error(llvm::Twine("failed to read '") + path +
+                             "': " + buffer.getError().message());
+  return (*buffer)->getBuffer().str();
+}
+
+/// Creates a new context with all dialects used by the compiler. Every
+/// benchmark iteration uses a fresh context as some attributes, such as
+/// 'py.globalValue's, are mutable and would otherwise leak state from one
+/// iteration into the next.
+std::unique_ptr<mlir::MLIRContext> createContext() {
+  mlir::DialectRegistry registry;
+  registry.insert<pylir::Py::PylirPyDialect>();
+  registry.insert<pylir::HIR::PylirHIRDialect>();
+  registry.insert<pylir::Mem::PylirMemDialect>();
+  registry.insert<mlir::arith::ArithDialect>();
+  registry.insert<mlir::LLVM::LLVMDialect>();
+  registry.insert<mlir::cf::ControlFlowDialect>();
+  registry.insert<mlir::DLTIDialect>();
+  pylir::registerExternalModels(registry);
+  mlir::registerLLVMDialectTranslation(registry);
+  mlir::registerBuiltinDialectTranslation(registry);
+  auto context = std::make_unique<mlir::MLIRContext>(registry);
+  context->disableMultithreading();
+  return context;
+}
+
+/// Creates the target machine for the host that all benchmarks compile for.
+std::unique_ptr<llvm::TargetMachine> createTargetMachine() {
+  std::string triple = llvm::sys::getDefaultTargetTriple();
+  std::string error;
+  const llvm::Target* target =
+      llvm::TargetRegistry::lookupTarget(triple, error);
+  if (!target)
+    llvm::report_fatal_error(llvm::Twine(error));
+
+  return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(
+      triple, llvm::sys::getHostCPUName(), "", {}, llvm::Reloc::PIC_,
+      std::nullopt, llvm::CodeGenOptLevel::Aggressive));
+}
+
+/// Parsed source file of a Python module.
+struct SourceModule {
+  pylir::Diag::Document document;
+  pylir::Diag::DiagnosticsDocManager<> docManager;
+  pylir::Syntax::FileInput fileInput;
+
+  SourceModule(pylir::Diag::DiagnosticsManager& diagManager,
+               const std::string& path)
+      : document(readFile(path), path),
+        docManager(diagManager.createSubDiagnosticManager(document)),
+        fileInput(parse(docManager)) {}
+
+private:
+  static pylir::Syntax::FileInput
+  parse(pylir::Diag::DiagnosticsDocManager<>& docManager) {
+    pylir::Parser parser(docManager);
+    std::optional<pylir::Syntax::FileInput> tree = parser.parseFileInput();
+    if (!tree || docManager.errorsOccurred())
+      llvm::report_fatal_error("failed to parse benchmark input");
+    return std::move(*tree);
+  }
+};
+
+/// Returns the path to the source file of 'module' or an empty string if it
+/// could not be found. Packages are preferred to plain modules just like in
+/// the compiler driver.
+std::string findModule(llvm::StringRef module,
+                       llvm::ArrayRef<std::string> importPaths) {
+  llvm::SmallVector<llvm::StringRef> components;
+  module.split(components, '.');
+  for (llvm::StringRef importPath : importPaths) {
+    llvm::SmallString<128> path = importPath;
+    for (llvm::StringRef component : components)
+      llvm::sys::path::append(path, component);
+
+    llvm::SmallString<128> package = path;
+    llvm::sys::path::append(package, "__init__.py");
+    if (llvm::sys::fs::exists(package))
+      return package.str().str();
+
+    path += ".py";
+    if (llvm::sys::fs::exists(path))
+      return path.str().str();
+  }
+  return "";
+}
+
+/// Compiles the program with the main module 'mainFile' including all modules
+/// it imports to a single module in the 'py' dialect. This is equivalent to
+/// the output of the compiler driver prior to running any pass pipeline.
+mlir::OwningOpRef<mlir::ModuleOp> codegenProgram(mlir::MLIRContext& context,
+                                                 llvm::StringRef mainFile) {
+  pylir::Diag::DiagnosticsManager diagManager;
+  std::vector<std::string> importPaths = {
+      llvm::sys::path::parent_path(mainFile).str(), PYLIR_BENCH_STDLIB_DIR};
+
+  // Modules are compiled one after another. 'std::list' keeps references to
+  // previously parsed modules stable.
+  std::list<SourceModule> sources;
+  std::vector<std::pair<std::string, std::string>> worklist = {
+      {"__main__", mainFile.str()}};
+  llvm::StringSet<> seen;
+
+  pylir::CodeGenOptions options;
+  options.moduleLoadCallback = [&](llvm::StringRef absoluteModule,
+                                   pylir::Diag::DiagnosticsDocManager<>*,
+                                   pylir::Diag::LazyLocation) {
+    if (!seen.insert(absoluteModule).second)
+      return;
+
+    std::string path = findModule(absoluteModule, importPaths);
+    if (path.empty())
+      llvm::report_fatal_error(llvm::Twine("failed to find module '") +
+                               absoluteModule + "'");
+    worklist.emplace_back(absoluteModule.str(), std::move(path));
+  };
+
+  std::vector<mlir::OwningOpRef<mlir::ModuleOp>> modules;
+  while (!worklist.empty()) {
+    auto [qualifier, path] = std::move(worklist.back());
+    worklist.pop_back();
+
+    SourceModule& source = sources.emplace_back(diagManager, path);
+    options.qualifier = std::move(qualifier);
+    modules.push_back(pylir::codegenModule(&context, source.fileInput,
+                                           source.docManager, options));
+    if (source.docManager.errorsOccurred())
+      llvm::report_fatal_error("failed to compile benchmark input");
+  }
+  return pylir::linkModules(modules);
+}
+
+/// Runs 'pipeline' on 'module'.
+void runPipeline(mlir::ModuleOp module, llvm::StringRef pipeline) {
+  mlir::PassManager manager(module->getContext());
+  if (mlir::failed(mlir::parsePassPipeline(pipeline, manager)) ||
+      mlir::failed(manager.run(module)))
+    llvm::report_fatal_error(llvm::Twine("failed to run '") + pipeline + "'");
+}
+
+/// Returns the 'pylir-llvm' pipeline for the host.
+std::string getLLVMPipeline() {
+  std::unique_ptr<llvm::TargetMachine> targetMachine = createTargetMachine();
+  return "pylir-llvm" +
+         pylir::PylirLLVMOptions(
+             targetMachine->getTargetTriple().str(),
+             targetMachine->createDataLayout().getStringRepresentation(),
+             /*produceDebugInfo=*/false)
+             .rendered();
+}
+
+/// Compiles 'mainFile' and runs all of 'pipelines' on it. The result is
+/// returned as bytecode to allow each iteration to start from a fresh context.
+std::string prepareModule(llvm::StringRef mainFile,
+                          llvm::ArrayRef<std::string> pipelines) {
+  std::unique_ptr<mlir::MLIRContext> context = createContext();
+  mlir::OwningOpRef<mlir::ModuleOp> module =
+      codegenProgram(*context, mainFile);
+  for (const std::string& pipeline : pipelines)
+    runPipeline(*module, pipeline);
+
+  std::string bytecode;
+  llvm::raw_string_ostream os(bytecode);
+  if (mlir::failed(mlir::writeBytecodeToFile(*module, os)))
+    llvm::report_fatal_error("failed to write bytecode");
+  return bytecode;
+}
+
+mlir::OwningOpRef<mlir::ModuleOp> loadModule(mlir::MLIRContext& context,
+                                             llvm::StringRef bytecode) {
+  mlir::OwningOpRef<mlir::ModuleOp> module =
+      mlir::parseSourceString<mlir::ModuleOp>(bytecode,
+                                              mlir::ParserConfig(&context));
+  if (!module)
+    llvm::report_fatal_error("failed to read bytecode");
+  return module;
+}
+
+//===----------------------------------------------------------------------===//
+// Benchmarks
+//===----------------------------------------------------------------------===//
+
+void benchmarkLexer(benchmark::State& state, const std::string& file) {
+  std::string source = readFile(file);
+  pylir::Diag::Document document(source, file);
+  pylir::Diag::DiagnosticsManager diagManager;
+  auto docManager = diagManager.createSubDiagnosticManager(document);
+  for (auto _ : state) {
+    pylir::Lexer lexer(docManager);
+    for (const pylir::Token& token : lexer)
+      benchmark::DoNotOptimize(token);
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+void benchmarkParser(benchmark::State& state, const std::string& file) {
+  std::string source = readFile(file);
+  pylir::Diag::Document document(source, file);
+  pylir::Diag::DiagnosticsManager diagManager;
+  auto docManager = diagManager.createSubDiagnosticManager(document);
+  for (auto _ : state) {
+    pylir::Parser parser(docManager);
+    std::optional<pylir::Syntax::FileInput> tree = parser.parseFileInput();
+    benchmark::DoNotOptimize(tree);
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+void benchmarkCodeGen(benchmark::State& state, const std::string& file) {
+  pylir::Diag::DiagnosticsManager diagManager;
+  SourceModule source(diagManager, file);
+
+  // Only the main module is measured. Imports such as 'builtins' are not
+  // compiled.
+  pylir::CodeGenOptions options;
+  options.qualifier = "__main__";
+  options.moduleLoadCallback = [](llvm::StringRef,
+                                  pylir::Diag::DiagnosticsDocManager<>*,
+                                  pylir::Diag::LazyLocation) {};
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<mlir::MLIRContext> context = createContext();
+    state.ResumeTiming();
+
+    mlir::OwningOpRef<mlir::ModuleOp> module = pylir::codegenModule(
+        context.get(), source.fileInput, source.docManager, options);
+    benchmark::DoNotOptimize(module);
+
+    state.PauseTiming();
+    module = nullptr;
+    context.reset();
+    state.ResumeTiming();
+  }
+}
+
+/// Measures 'pipeline' on the output of 'prerequisites'.
+void benchmarkPipeline(benchmark::State& state, const std::string& file,
+                       const std::vector<std::string>& prerequisites,
+                       const std::string& pipeline) {
+  std::string input = prepareModule(file, prerequisites);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<mlir::MLIRContext> context = createContext();
+    mlir::OwningOpRef<mlir::ModuleOp> module = loadModule(*context, input);
+    mlir::PassManager manager(context.get());
+    if (mlir::failed(mlir::parsePassPipeline(pipeline, manager)))
+      llvm::report_fatal_error("failed to parse pipeline");
+    state.ResumeTiming();
+
+    if (mlir::failed(manager.run(*module)))
+      llvm::report_fatal_error("failed to run pipeline");
+
+    state.PauseTiming();
+    module = nullptr;
+    context.reset();
+    state.ResumeTiming();
+  }
+}
+
+/// Measures the translation to LLVM IR, the LLVM optimization pipeline and the
+/// emission of an object file, mirroring the compiler driver at '-O3'.
+void benchmarkBackend(benchmark::State& state, const std::string& file) {
+  std::string input =
+      prepareModule(file, {"pylir-optimize", getLLVMPipeline()});
+  std::unique_ptr<llvm::TargetMachine> targetMachine = createTargetMachine();
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<mlir::MLIRContext> context = createContext();
+    mlir::OwningOpRef<mlir::ModuleOp> mlirModule =
+        loadModule(*context, input);
+    llvm::LLVMContext llvmContext;
+    state.ResumeTiming();
+
+    std::unique_ptr<llvm::Module> llvmModule =
+        mlir::translateModuleToLLVMIR(*mlirModule, llvmContext);
+    if (!llvmModule)
+      llvm::report_fatal_error("failed to translate to LLVM IR");
+
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder passBuilder(targetMachine.get());
+    passBuilder.registerOptimizerLastEPCallback(
+        [&](llvm::ModulePassManager& mpm, llvm::OptimizationLevel) {
+          mpm.addPass(pylir::PlaceStatepointsPass{});
+        });
+    fam.registerPass([&] { return passBuilder.buildDefaultAAPipeline(); });
+    passBuilder.registerModuleAnalyses(mam);
+    passBuilder.registerCGSCCAnalyses(cgam);
+    passBuilder.registerFunctionAnalyses(fam);
+    passBuilder.registerLoopAnalyses(lam);
+    passBuilder.crossRegisterProxies(lam, fam, cgam, mam);
+    passBuilder
+        .buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3)
+        .run(*llvmModule, mam);
+
+    llvm::SmallString<0> object;
+    llvm::raw_svector_ostream os(object);
+    llvm::legacy::PassManager codeGenPasses;
+    if (targetMachine->addPassesToEmitFile(codeGenPasses, os, nullptr,
+                                           llvm::CodeGenFileType::ObjectFile))
+      llvm::report_fatal_error("target does not support object files");
+    codeGenPasses.run(*llvmModule);
+    benchmark::DoNotOptimize(object);
+  }
+}
+
+void registerBenchmarks(const std::string& file) {
+  std::string name = llvm::sys::path::stem(file).str();
+  auto registerBenchmark = [&](llvm::StringRef stage, auto&& function,
+                               auto&&... args) {
+    benchmark::RegisterBenchmark((stage + "/" + name).str(), function, file,
+                                 args...)
+        ->Unit(benchmark::kMillisecond);
+  };
+
+  registerBenchmark("Lex", benchmarkLexer);
+  registerBenchmark("Parse", benchmarkParser);
+  registerBenchmark("CodeGen", benchmarkCodeGen);
+  registerBenchmark("pylir-minimum", benchmarkPipeline,
+                    std::vector<std::string>{}, std::string("pylir-minimum"));
+  registerBenchmark("pylir-optimize", benchmarkPipeline,
+                    std::vector<std::string>{}, std::string("pylir-optimize"));
+  registerBenchmark("pylir-llvm", benchmarkPipeline,
+                    std::vector<std::string>{"pylir-optimize"},
+                    getLLVMPipeline());
+  registerBenchmark("Backend", benchmarkBackend);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+  pylir::linkInGCStrategy();
+  pylir::registerOptimizationPipelines();
+
+  benchmark::Initialize(&argc, argv);
+
+  // Any arguments not consumed by the benchmark library are Python files used
+  // instead of the default corpus.
+  std::vector<std::string> files(argv + 1, argv + argc);
+  if (files.empty())
+    for (const char* name : {"small", "medium", "large"})
+      files.push_back((llvm::Twine(PYLIR_BENCH_CORPUS_DIR) + "/" + name + ".py")
+                          .str());
+
+  for (const std::string& file : files)
+    registerBenchmarks(file);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,183 @@
+#  Licensed under the Apache License v2.0 with LLVM Exceptions.
+#  See https://llvm.org/LICENSE.txt for license information.
+#  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Generates the synthetic Python programs used as corpus by the compile-time
+benchmarks. The programs only make use of language features and builtins
+supported by pylir and are meant to resemble typical application code:
+classes with methods, nested functions with closures, loops, exception
+handling, dictionaries and tuples.
+
+The output is fully deterministic for a given size to make measurements
+comparable across builds.
+"""
+
+import argparse
+import pathlib
+import random
+
+SIZES = {
+    'small': 50,
+    'medium': 500,
+    'large': 2000,
+}
+
+
+def gen_class(rng: random.Random, i: int) -> str:
+    fields = [f'f{j}' for j in range(rng.randint(2, 5))]
+    init_args = ', '.join(fields)
+    init_body = '\n'.join(f'        self.{f} = {f}' for f in fields)
+    sum_expr = ' + '.join(f'self.{f}' for f in fields)
+    return f'''
+class Class{i}:
+    kind = {i}
+
+    def __init__(self, {init_args}):
+{init_body}
+
+    def total(self):
+        return {sum_expr}
+
+    def scaled(self, factor):
+        if factor == 0:
+            return self.kind
+        return self.total() * factor + self.kind
+
+    def __repr__(self):
+        return "Class{i}"
+
+
+def use_class{i}():
+    obj = Class{i}({', '.join(str(rng.randint(0, 100)) for _ in fields)})
+    if isinstance(obj, Class{i}):
+        return obj.scaled({rng.randint(1, 9)})
+    return 0
+'''
+
+
+def gen_loop(rng: random.Random, i: int) -> str:
+    bound = rng.randint(10, 1000)
+    return f'''
+def loop{i}(n):
+    total = 0
+    i = 0
+    while i < n:
+        if i % {rng.randint(2, 7)} == 0:
+            total += i * {rng.randint(1, 5)}
+        elif i % {rng.randint(2, 7)} == 1:
+            total -= i
+        else:
+            total = total + 1
+        i += 1
+    for value in (1, 2, 3, {rng.randint(4, 100)}):
+        total += value
+    return total
+
+
+def use_loop{i}():
+    return loop{i}({bound})
+'''
+
+
+def gen_closure(rng: random.Random, i: int) -> str:
+    return f'''
+def make_counter{i}(start):
+    count = start
+
+    def increment(step=1):
+        nonlocal count
+        count += step
+        return count
+
+    return increment
+
+
+def use_closure{i}():
+    counter = make_counter{i}({rng.randint(0, 10)})
+    counter()
+    counter({rng.randint(1, 5)})
+    apply = lambda f, x: f(x)
+    return apply(counter, {rng.randint(1, 5)})
+'''
+
+
+def gen_exception(rng: random.Random, i: int) -> str:
+    key = rng.randint(0, 10)
+    return f'''
+def lookup{i}(table, key):
+    try:
+        return table[key]
+    except KeyError:
+        return None
+    finally:
+        pass
+
+
+def use_exception{i}():
+    table = {{{', '.join(f'{k}: "{k}"' for k in range(rng.randint(1, 8)))}}}
+    result = lookup{i}(table, {key})
+    try:
+        if result is None:
+            raise ValueError("missing")
+    except ValueError as e:
+        return repr(e)
+    return result
+'''
+
+
+def gen_tuples(rng: random.Random, i: int) -> str:
+    count = rng.randint(2, 6)
+    elements = ', '.join(str(rng.randint(0, 100)) for _ in range(count))
+    return f'''
+def tuples{i}(*args, **kwargs):
+    first, *rest = ({elements},)
+    a, b = len(rest), len(args)
+    seq = (a, b, first)
+    if first in seq and not (a > b):
+        return hash(seq) + len(kwargs)
+    return id(seq)
+
+
+def use_tuples{i}():
+    return tuples{i}(1, 2, key={rng.randint(0, 9)})
+'''
+
+
+GENERATORS = [gen_class, gen_loop, gen_closure, gen_exception, gen_tuples]
+
+
+def generate(units: int) -> str:
+    rng = random.Random(units)
+    chunks = []
+    calls = []
+    for i in range(units):
+        gen = rng.choice(GENERATORS)
+        chunks.append(gen(rng, i))
+        calls.append(f'use_{gen.__name__[len("gen_"):]}{i}()')
+
+    main = '\n'.join(f'    results = (results, {c})' for c in calls)
+    chunks.append(f'''
+def main():
+    results = None
+{main}
+    print(len(results))
+
+
+main()
+''')
+    return ''.join(chunks)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('output_dir', type=pathlib.Path)
+    args = parser.parse_args()
+
+    args.output_dir.mkdir(parents=True, exist_ok=True)
+    for name, units in SIZES.items():
+        (args.output_dir / f'{name}.py').write_text(generate(units))
+
+
+if __name__ == '__main__':
+    main()
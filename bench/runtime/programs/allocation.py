@@ -0,0 +1,35 @@
+# Allocation heavy code creating many short-lived objects. Stresses the
+# allocator and the garbage collector.
+
+class Node:
+    def __init__(self, value, next):
+        self.value = value
+        self.next = next
+
+
+def build(length):
+    head = None
+    i = 0
+    while i < length:
+        head = Node(i, head)
+        i += 1
+    return head
+
+
+def total(head):
+    result = 0
+    while head is not None:
+        result += head.value
+        head = head.next
+    return result
+
+
+result = 0
+i = 0
+while i < 200:
+    result += total(build(10000))
+    pair = (i, (i, i), [i])
+    i += 1
+
+print(result)
+print(len(pair))
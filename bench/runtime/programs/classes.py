@@ -0,0 +1,47 @@
+# Class heavy code. Stresses attribute access, method dispatch through the MRO
+# and object allocation.
+
+class Shape:
+    sides = 0
+
+    def __init__(self, size):
+        self.size = size
+
+    def weight(self):
+        return self.sides + self.size
+
+
+class Triangle(Shape):
+    sides = 3
+
+
+class Square(Shape):
+    sides = 4
+
+    def weight(self):
+        return self.size + self.size
+
+
+class Pentagon(Square):
+    sides = 5
+
+
+class Counter:
+    def __init__(self):
+        self.value = 0
+
+    def add(self, shape):
+        self.value += shape.weight()
+
+
+shapes = (Triangle(1), Square(2), Pentagon(3), Shape(4))
+counter = Counter()
+i = 0
+while i < 500000:
+    for shape in shapes:
+        counter.add(shape)
+    Triangle(i)
+    i += 1
+
+print(counter.value)
+print(isinstance(shapes[2], Square))
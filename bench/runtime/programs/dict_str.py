@@ -0,0 +1,38 @@
+# Dictionary and string heavy code. Stresses hashing, string concatenation and
+# dictionary lookups and insertions.
+
+def build(count):
+    table = {}
+    i = 0
+    while i < count:
+        table["key" + repr(i)] = i
+        i += 1
+    return table
+
+
+def lookup(table, count, rounds):
+    hits = 0
+    r = 0
+    while r < rounds:
+        i = 0
+        while i < count:
+            if ("key" + repr(i)) in table:
+                hits += table["key" + repr(i)]
+            i += 1
+        r += 1
+    return hits
+
+
+def concat(count):
+    text = ""
+    i = 0
+    while i < count:
+        text = text + "x"
+        i += 1
+    return len(text)
+
+
+table = build(20000)
+print(len(table))
+print(lookup(table, 20000, 10))
+print(concat(20000))
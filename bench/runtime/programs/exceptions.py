@@ -0,0 +1,43 @@
+# Exception heavy code. Stresses raising, unwinding and catching exceptions
+# used as control flow.
+
+class Stop(Exception):
+    pass
+
+
+def raises(i):
+    if i == 3:
+        raise Stop()
+    return i
+
+
+def nested(depth, i):
+    if depth == 10:
+        return raises(i)
+    return nested(depth + 1, i)
+
+
+caught = 0
+total = 0
+i = 0
+while i < 200000:
+    try:
+        total += raises(3)
+    except Stop:
+        caught += 1
+
+    try:
+        total += nested(0, 3)
+    except Stop:
+        caught += 1
+
+    try:
+        {}[i]
+    except KeyError:
+        caught += 1
+    finally:
+        total += 1
+    i += 1
+
+print(caught)
+print(total)
@@ -0,0 +1,30 @@
+# Tight integer loops. Stresses integer arithmetic, comparisons and the
+# unboxing of integers within loops.
+
+def triangle(n):
+    total = 0
+    i = 0
+    while i < n:
+        total += i
+        i += 1
+    return total
+
+
+def fibonacci(n):
+    a = 0
+    b = 1
+    i = 0
+    while i < n:
+        a, b = b, a + b
+        i += 1
+    return a
+
+
+total = 0
+j = 0
+while j < 20:
+    total += triangle(200000)
+    j += 1
+
+print(total)
+print(fibonacci(1000))
@@ -0,0 +1,23 @@
+# Recursive calls. Stresses the calling convention, frame setup and inlining
+# of recursive functions.
+
+def tree(depth, limit):
+    if depth == limit:
+        return 1
+    return tree(depth + 1, limit) + tree(depth + 1, limit)
+
+
+def count(depth, limit, acc):
+    if depth == limit:
+        return acc
+    return count(depth + 1, limit, acc + depth)
+
+
+print(tree(0, 22))
+
+total = 0
+i = 0
+while i < 1000:
+    total += count(0, 500, 0)
+    i += 1
+print(total)
@@ -0,0 +1,190 @@
+#  Licensed under the Apache License v2.0 with LLVM Exceptions.
+#  See https://llvm.org/LICENSE.txt for license information.
+#  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+Compiles the runtime benchmark programs with pylir at various optimization
+levels and measures the resulting executables.
+
+For every program and optimization level, the wall time, the peak resident set
+size and the number of garbage collections are recorded. If 'perf' is
+available, the executable is additionally run once through 'perf stat' to
+collect hardware counters. The output of every executable is checked against
+the output of the '-O0' build to catch miscompilations.
+
+The results are written as JSON for tracking across builds.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import platform
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from typing import List, Optional
+
+PROGRAMS_DIR = pathlib.Path(__file__).parent / 'programs'
+
+PERF_EVENTS = ['cycles', 'instructions', 'branch-misses', 'cache-misses']
+
+GC_STATS_RE = re.compile(r'^pylir-gc-collections: (\d+)$', re.MULTILINE)
+
+
+def compile_program(pylir: str, source: pathlib.Path, opt_level: str,
+                    output: pathlib.Path, flags: List[str]) -> None:
+    subprocess.run([pylir, str(source), f'-O{opt_level}', '-o', str(output)]
+                   + flags, check=True)
+
+
+def run_once(executable: pathlib.Path) -> dict:
+    """
+    Runs 'executable' and returns its output, wall time and number of garbage
+    collections.
+    """
+    env = dict(os.environ, PYLIR_GC_STATS='1')
+    start = time.perf_counter()
+    process = subprocess.Popen([str(executable)], stdout=subprocess.PIPE,
+                               stderr=subprocess.PIPE, env=env)
+    stdout, stderr = process.communicate()
+    wall_time = time.perf_counter() - start
+    if process.returncode != 0:
+        raise RuntimeError(f'{executable} exited with {process.returncode}:\n'
+                           + stderr.decode(errors='replace'))
+
+    match = GC_STATS_RE.search(stderr.decode(errors='replace'))
+    return {
+        'stdout': stdout,
+        'wall_time_s': wall_time,
+        'gc_collections': int(match.group(1)) if match else None,
+    }
+
+
+def run_perf(perf: str, executable: pathlib.Path) -> dict:
+    """
+    Runs 'executable' through 'perf stat' and returns the hardware counters.
+    """
+    with tempfile.NamedTemporaryFile(mode='r', suffix='.csv') as output:
+        subprocess.run([perf, 'stat', '-x', ',', '-o', output.name, '-e',
+                        ','.join(PERF_EVENTS), '--', str(executable)],
+                       stdout=subprocess.DEVNULL, check=True)
+        counters = {}
+        for line in output:
+            fields = line.strip().split(',')
+            if len(fields) < 3 or fields[2] not in PERF_EVENTS:
+                continue
+            try:
+                counters[fields[2]] = int(fields[0])
+            except ValueError:
+                # '<not supported>' or '<not counted>'.
+                counters[fields[2]] = None
+        return counters
+
+
+def peak_rss(executable: pathlib.Path) -> Optional[int]:
+    """
+    Returns the peak RSS of 'executable' in KiB. 'executable' is run in a fresh
+    child process as the resource usage of children can otherwise only be
+    queried accumulated over all of them. Returns None on Windows where 'wait4'
+    is not available.
+    """
+    if not hasattr(os, 'wait4'):
+        return None
+
+    pid = os.fork()
+    if pid == 0:
+        devnull = os.open(os.devnull, os.O_WRONLY)
+        os.dup2(devnull, 1)
+        os.dup2(devnull, 2)
+        os.execv(str(executable), [str(executable)])
+
+    _, status, usage = os.wait4(pid, 0)
+    if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0:
+        return None
+    return usage.ru_maxrss // 1024 if sys.platform == 'darwin' \
+        else usage.ru_maxrss
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--pylir', required=True, help='Path to pylir')
+    parser.add_argument('--output', type=pathlib.Path,
+                        help='File to write the JSON results to')
+    parser.add_argument('--opt-levels', nargs='+', default=['0', '1', '3'])
+    parser.add_argument('--repetitions', type=int, default=5)
+    parser.add_argument('--filter', default='',
+                        help='Only run programs whose name contains FILTER')
+    parser.add_argument('--no-perf', action='store_true',
+                        help='Do not run the programs through perf stat')
+    parser.add_argument('--flags', nargs=argparse.REMAINDER, default=[],
+                        help='Additional flags passed to pylir')
+    args = parser.parse_args()
+
+    perf = None if args.no_perf else shutil.which('perf')
+    programs = sorted(p for p in PROGRAMS_DIR.glob('*.py')
+                      if args.filter in p.stem)
+
+    results = []
+    with tempfile.TemporaryDirectory() as tmp:
+        for program in programs:
+            reference_output = None
+            for opt_level in args.opt_levels:
+                executable = pathlib.Path(tmp) / f'{program.stem}-O{opt_level}'
+                compile_program(args.pylir, program, opt_level, executable,
+                                args.flags)
+
+                runs = [run_once(executable) for _ in range(args.repetitions)]
+                output = runs[0]['stdout']
+                if reference_output is None:
+                    reference_output = output
+                elif output != reference_output:
+                    raise RuntimeError(f'output of {program.name} at '
+                                       f'-O{opt_level} differs from '
+                                       f'-O{args.opt_levels[0]}')
+
+                wall_times = [r['wall_time_s'] for r in runs]
+                result = {
+                    'name': program.stem,
+                    'opt_level': opt_level,
+                    'repetitions': args.repetitions,
+                    'wall_time_s': {
+                        'min': min(wall_times),
+                        'median': statistics.median(wall_times),
+                        'max': max(wall_times),
+                    },
+                    'peak_rss_kb': peak_rss(executable),
+                    'gc_collections': runs[0]['gc_collections'],
+                }
+                if perf:
+                    result['perf'] = run_perf(perf, executable)
+                results.append(result)
+
+                print(f'{program.stem:<16} -O{opt_level}  '
+                      f'{result["wall_time_s"]["median"]:8.3f}s  '
+                      f'{result["peak_rss_kb"] or 0:>8} KiB  '
+                      f'{result["gc_collections"] or 0:>6} GCs',
+                      file=sys.stderr, flush=True)
+
+    report = {
+        'context': {
+            'date': time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+            'host': platform.node(),
+            'machine': platform.machine(),
+            'system': platform.system(),
+            'pylir_flags': args.flags,
+        },
+        'benchmarks': results,
+    }
+    if args.output:
+        args.output.write_text(json.dumps(report, indent=2))
+    else:
+        json.dump(report, sys.stdout, indent=2)
+
+
+if __name__ == '__main__':
+    main()
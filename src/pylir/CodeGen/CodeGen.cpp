@@ -33,6 +33,9 @@ class CodeGen {
   Py::GlobalValueAttr m_thisModuleObject;
   Py::GlobalValueAttr m_globalDictionary;
   llvm::DenseMap<llvm::StringRef, Py::GlobalValueAttr> m_builtinNamespace;
+  /// Whether the initialization of this module is deferred until the first
+  /// access of one of its globals.
+  bool m_lazyInit = false;
 
   /// Struct representing one instance of a scope in Python.
   /// The map contains a mapping for all local and free variables used within
@@ -42,6 +45,9 @@ class CodeGen {
     using Identifier = std::variant<SSABuilder::DefinitionsMap, Value>;
     llvm::DenseMap<llvm::StringRef, Identifier> identifiers;
     SSABuilder ssaBuilder;
+    /// Whether any global variable of the module is read or written within
+    /// the scope.
+    bool accessesModuleGlobals = false;
 
     /// Constructs a scope and uses 'builder' to create any unbound variables.
     Scope(ImplicitLocOpBuilder& builder)
@@ -360,6 +366,14 @@ class CodeGen {
     }
   }
 
+  /// Returns the dictionary containing all global variables of the module.
+  /// Must be used for any access of a global variable.
+  Value getGlobalDictionary() {
+    if (m_functionScope)
+      m_functionScope->accessesModuleGlobals = true;
+    return create<Py::ConstantOp>(m_globalDictionary);
+  }
+
   /// Generates code to insert 'value' into 'dictionary' with the key 'name'.
   void dictionaryStringInsertion(Value dictionary, StringRef name,
                                  Value value) {
@@ -401,8 +415,7 @@ class CodeGen {
       }
     }
 
-    dictionaryStringInsertion(create<Py::ConstantOp>(m_globalDictionary), name,
-                              value);
+    dictionaryStringInsertion(getGlobalDictionary(), name, value);
   }
 
   void eraseIdentifier(StringRef name) {
@@ -446,8 +459,7 @@ class CodeGen {
     };
 
     auto globalLookup = [&]() -> Value {
-      Value readValue = dictionaryStringLookup(
-          create<Py::ConstantOp>(m_globalDictionary), name);
+      Value readValue = dictionaryStringLookup(getGlobalDictionary(), name);
       auto iter = m_builtinNamespace.find(name);
       if (iter == m_builtinNamespace.end())
         return readValue;
@@ -680,7 +692,13 @@ public:
         1));
     m_builder.setInsertionPointToEnd(m_module.getBody());
 
-    auto init = create<HIR::InitOp>(m_options.qualifier);
+    // Modules with observable effects at the top level must be initialized by
+    // the import statement, as required by Python semantics.
+    m_lazyInit = m_options.lazyModuleInit &&
+                 m_options.qualifier != "__main__" &&
+                 onlyDefinesGlobals(fileInput.input);
+
+    auto init = create<HIR::InitOp>(m_options.qualifier, m_lazyInit);
     m_qualifiers = init.getName();
 
     auto* entryBlock = new mlir::Block;
@@ -701,7 +719,8 @@ public:
     if (m_options.qualifier == "__main__" && m_options.implicitBuiltinsImport) {
       m_options.moduleLoadCallback("builtins", m_docManager,
                                    /*location=*/std::nullopt);
-      create<HIR::InitModuleOp>("builtins");
+      create<HIR::InitModuleOp>("builtins",
+                                /*deferrable=*/m_options.lazyModuleInit);
       auto builtinNone =
           m_builder.getAttr<Py::GlobalValueAttr>(Builtins::None.name);
       builtinNone.setConstant(true);
@@ -730,6 +749,65 @@ public:
   }
 
 private:
+  /// Returns true if executing 'suite' as the top level of a module has no
+  /// observable effects besides defining the global variables of the module.
+  /// This is a conservative syntactic check only allowing 'pass', literals,
+  /// assignments of literals to identifiers, function definitions without
+  /// any evaluated expressions and const class definitions.
+  static bool onlyDefinesGlobals(const Syntax::Suite& suite) {
+    auto isLiteral = [](const Syntax::Expression& expression) {
+      const auto* atom = expression.dyn_cast<Syntax::Atom>();
+      return atom && atom->token.getTokenType() != TokenType::Identifier;
+    };
+    auto isIdentifier = [](const Syntax::Target& target) {
+      const auto* atom = target.dyn_cast<Syntax::Atom>();
+      return atom && atom->token.getTokenType() == TokenType::Identifier;
+    };
+
+    return llvm::all_of(suite.statements, [&](const auto& variant) {
+      return match(
+          variant,
+          [&](const IntrVarPtr<Syntax::SimpleStmt>& simpleStmt) {
+            if (const auto* singleToken =
+                    simpleStmt->dyn_cast<Syntax::SingleTokenStmt>())
+              return singleToken->token.getTokenType() ==
+                     TokenType::PassKeyword;
+
+            if (const auto* expressionStmt =
+                    simpleStmt->dyn_cast<Syntax::ExpressionStmt>())
+              return isLiteral(*expressionStmt->expression);
+
+            const auto* assignment =
+                simpleStmt->dyn_cast<Syntax::AssignmentStmt>();
+            return assignment && !assignment->maybeAnnotation &&
+                   assignment->maybeExpression &&
+                   isLiteral(*assignment->maybeExpression) &&
+                   llvm::all_of(assignment->targets, [&](const auto& pair) {
+                     return isIdentifier(*pair.first);
+                   });
+          },
+          [&](const IntrVarPtr<Syntax::CompoundStmt>& compoundStmt) {
+            if (const auto* classDef =
+                    compoundStmt->dyn_cast<Syntax::ClassDef>())
+              return classDef->isConst;
+
+            const auto* funcDef = compoundStmt->dyn_cast<Syntax::FuncDef>();
+            return funcDef && !funcDef->maybeSuffix &&
+                   llvm::all_of(funcDef->decorators,
+                                [](const Syntax::Decorator& decorator) {
+                                  return isa<Syntax::Intrinsic>(
+                                      *decorator.expression);
+                                }) &&
+                   llvm::all_of(funcDef->parameterList,
+                                [&](const Syntax::Parameter& parameter) {
+                                  return !parameter.maybeType &&
+                                         (!parameter.maybeDefault ||
+                                          isLiteral(*parameter.maybeDefault));
+                                });
+          });
+    });
+  }
+
   //===--------------------------------------------------------------------===//
   // Statements
   //===--------------------------------------------------------------------===//
@@ -818,6 +896,14 @@ private:
           m_builder.getContext(), Builtins::None.name));
       create<HIR::ReturnOp>(ref);
     }
+
+    // With lazy module initialization, the first function accessing the
+    // global variables of the module is responsible for initializing it.
+    if (m_lazyInit && m_functionScope->accessesModuleGlobals) {
+      OpBuilder::InsertionGuard guard{m_builder};
+      m_builder.setInsertionPointToStart(&region.front());
+      m_builder.create<HIR::InitModuleOp>(m_options.qualifier);
+    }
   }
 
   Value visitFunction(ArrayRef<Syntax::Decorator>,
@@ -1399,9 +1485,12 @@ private:
 
         m_options.moduleLoadCallback(moduleQualifier, m_docManager,
                                      Diag::rangeLoc(moduleSpec.identifiers));
-        // TODO: Ensure modules are not initialized more than once.
         // TODO: Throw import errors if import failed?
-        create<HIR::InitModuleOp>(moduleQualifier);
+        // Lazily initialized modules are initialized by the first function
+        // accessing its globals instead, making the initialization at the
+        // import statement unnecessary.
+        create<HIR::InitModuleOp>(moduleQualifier,
+                                  /*deferrable=*/m_options.lazyModuleInit);
       }
     }
   }
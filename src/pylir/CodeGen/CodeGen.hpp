@@ -38,6 +38,12 @@ struct CodeGenOptions {
 
   /// Whether '__main__' should import 'builtins'.
   bool implicitBuiltinsImport = true;
+
+  /// Whether the initialization of imported modules should be deferred.
+  /// If true, import statements do not initialize the module. Instead, any
+  /// function accessing the global variables of a module other than '__main__'
+  /// initializes the module on entry.
+  bool lazyModuleInit = false;
 };
 
 /// Performs code generation from the AST of a python module, to MLIR.
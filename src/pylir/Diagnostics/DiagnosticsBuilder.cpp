@@ -21,30 +21,38 @@ void pylir::Diag::Diagnostic::printLine(llvm::raw_ostream& os,
                                         const Document& document,
                                         std::vector<Highlight> highlights) {
   os << fmt::format("{1: >{0}} | ", width, lineNumber);
-  auto line = document.getLine(lineNumber);
+  auto utf8Line = document.getLine(lineNumber);
   if (highlights.empty()) {
-    os << Text::toUTF8String(line) << "\n";
+    os << utf8Line << "\n";
     return;
   }
-  auto offset = line.data() - document.getText().data();
+  // Highlights are given as byte offsets into the document. Rendering works on
+  // codepoints, so the line is decoded and the highlights converted to
+  // codepoint indices within the line.
+  std::size_t lineStart = utf8Line.data() - document.getText().data();
+  for (auto& iter : highlights) {
+    iter.start = document.countCodepoints(lineStart, iter.start);
+    iter.end = document.countCodepoints(lineStart, iter.end);
+  }
+  std::u32string utf32Line = Text::toUTF32String(utf8Line);
+  std::u32string_view line = utf32Line;
   {
     std::size_t lastEnd = 0;
     for (auto& iter : highlights) {
-      os << Text::toUTF8String(
-          line.substr(lastEnd, iter.start - offset - lastEnd));
+      os << Text::toUTF8String(line.substr(lastEnd, iter.start - lastEnd));
       fmt::text_style style;
       if (iter.optionalColour && os.has_colors())
         style |= fmt::fg(*iter.optionalColour);
       if (iter.optionalEmphasis && os.has_colors())
         style |= *iter.optionalEmphasis;
       // If not pointing at newline
-      if (iter.start - offset != line.size()) {
-        os << fmt::format(style, "{}",
-                          Text::toUTF8String(line.substr(
-                              iter.start - offset, iter.end - iter.start)));
+      if (iter.start != line.size()) {
+        os << fmt::format(
+            style, "{}",
+            Text::toUTF8String(line.substr(iter.start, iter.end - iter.start)));
       }
 
-      lastEnd = iter.end - offset;
+      lastEnd = iter.end;
     }
     if (lastEnd <= line.size()) {
       os << Text::toUTF8String(line.substr(lastEnd));
@@ -58,8 +66,7 @@ void pylir::Diag::Diagnostic::printLine(llvm::raw_ostream& os,
     std::u32string underlines;
     underlines.reserve(line.size());
     for (auto& iter : highlights) {
-      for (auto codepoint :
-           line.substr(lastEnd, iter.start - offset - lastEnd)) {
+      for (auto codepoint : line.substr(lastEnd, iter.start - lastEnd)) {
         if (Text::isWhitespace(codepoint)) {
           underlines += codepoint;
           continue;
@@ -67,16 +74,16 @@ void pylir::Diag::Diagnostic::printLine(llvm::raw_ostream& os,
         auto consoleWidth = Text::consoleWidth(codepoint);
         underlines.insert(underlines.end(), consoleWidth, U' ');
       }
-      lastEnd = iter.end - offset;
+      lastEnd = iter.end;
       fmt::text_style style;
       if (iter.optionalColour && os.has_colors())
         style = fmt::fg(*iter.optionalColour);
 
-      if (iter.start - offset == line.size()) {
+      if (iter.start == line.size()) {
         underlines += fmt::format(style, U"^");
         continue;
       }
-      auto substr = line.substr(iter.start - offset, iter.end - iter.start);
+      auto substr = line.substr(iter.start, iter.end - iter.start);
       if (substr.size() == 1) {
         auto consoleWidth = Text::consoleWidth(substr.front());
         underlines += fmt::format(style, U"{0:^^{1}}", U"", consoleWidth);
@@ -109,7 +116,7 @@ void pylir::Diag::Diagnostic::printLine(llvm::raw_ostream& os,
       if (iter.optionalColour && os.has_colors())
         style = fmt::fg(*iter.optionalColour);
 
-      auto thisMid = (iter.end - iter.start) / 2 + iter.start - offset;
+      auto thisMid = (iter.end - iter.start) / 2 + iter.start;
       for (auto codepoint : line.substr(lastEnd, thisMid - lastEnd)) {
         if (Text::isWhitespace(codepoint)) {
           underlines += codepoint;
@@ -136,7 +143,7 @@ void pylir::Diag::Diagnostic::printLine(llvm::raw_ostream& os,
         if (iter->optionalColour && os.has_colors())
           style = fmt::fg(*iter->optionalColour);
 
-        auto thisMid = (iter->end - iter->start) / 2 + iter->start - offset;
+        auto thisMid = (iter->end - iter->start) / 2 + iter->start;
         for (auto codepoint : line.substr(lastEnd, thisMid - lastEnd)) {
           if (Text::isWhitespace(codepoint)) {
             underlines += codepoint;
@@ -153,7 +160,7 @@ void pylir::Diag::Diagnostic::printLine(llvm::raw_ostream& os,
                             });
         if (auto next = iter + 1; next != highlights.end()) {
           std::size_t widthTillNext = 0;
-          auto nextMid = (next->end - next->start) / 2 + next->start - offset;
+          auto nextMid = (next->end - next->start) / 2 + next->start;
           for (std::size_t i = thisMid; i < nextMid; i++)
             widthTillNext += Text::consoleWidth(line[i]);
 
@@ -291,8 +298,7 @@ llvm::raw_ostream& pylir::Diag::operator<<(llvm::raw_ostream& os,
   for (std::size_t i = std::max<std::ptrdiff_t>(
            1, static_cast<std::ptrdiff_t>(*neededLines.begin()) - margin);
        i < *neededLines.begin(); i++) {
-    os << fmt::format("{1: >{0}} | {2}\n", width, i,
-                      Text::toUTF8String(document.getLine(i)));
+    os << fmt::format("{1: >{0}} | {2}\n", width, i, document.getLine(i));
   }
   for (std::size_t i : neededLines) {
     auto& set = highlighted[i];
@@ -302,8 +308,7 @@ llvm::raw_ostream& pylir::Diag::operator<<(llvm::raw_ostream& os,
   }
   for (std::size_t i = largestLine + 1;
        i < largestLine + margin + 1 && document.hasLine(i); i++)
-    os << fmt::format("{1: >{0}} | {2}\n", width, i,
-                      Text::toUTF8String(document.getLine(i)));
+    os << fmt::format("{1: >{0}} | {2}\n", width, i, document.getLine(i));
 
   return os;
 }
@@ -4,11 +4,97 @@
 
 #include "Document.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint64_t broadcast(std::uint8_t byte) {
+  return std::uint64_t{0x0101010101010101} * byte;
+}
+
+/// Returns true if any of the 8 bytes within 'word' is either not ASCII or a
+/// line terminator. May spuriously return true for a word that contains
+/// neither, but never returns false if it does.
+bool requiresDecoding(std::uint64_t word) {
+  auto hasZeroByte = [](std::uint64_t value) {
+    return (value - broadcast(0x01)) & ~value & broadcast(0x80);
+  };
+  return (word & broadcast(0x80)) | hasZeroByte(word ^ broadcast('\n')) |
+         hasZeroByte(word ^ broadcast('\r'));
+}
+
+} // namespace
+
+void pylir::Diag::Document::appendCodepoint(char32_t codepoint) {
+  if (codepoint < 0x80) {
+    m_text += static_cast<char>(codepoint);
+    return;
+  }
+  auto utf8 = Text::toUTF8(codepoint);
+  m_text.append(utf8.data(),
+                std::find(utf8.begin(), utf8.end(), '\0') - utf8.begin());
+}
+
+void pylir::Diag::Document::copyUTF8(std::string_view input) {
+  while (!input.empty()) {
+    // Source code is almost exclusively ASCII. Copy runs of ASCII characters
+    // 8 bytes at a time and only validate the remaining characters one by one.
+    std::size_t asciiRun = 0;
+    while (input.size() - asciiRun >= sizeof(std::uint64_t)) {
+      std::uint64_t word;
+      std::memcpy(&word, input.data() + asciiRun, sizeof(std::uint64_t));
+      if (requiresDecoding(word))
+        break;
+      asciiRun += sizeof(std::uint64_t);
+    }
+    m_text.append(input.data(), asciiRun);
+    input.remove_prefix(asciiRun);
+    if (input.empty())
+      break;
+
+    switch (input.front()) {
+    case '\r':
+    case '\n':
+      // Both '\r\n' and a sole '\r' are normalized to '\n'.
+      if (input.substr(0, 2) == "\r\n")
+        input.remove_prefix(1);
+      input.remove_prefix(1);
+      m_text += '\n';
+      m_lineStarts.push_back(m_text.size());
+      break;
+    default:
+      if (static_cast<unsigned char>(input.front()) < 0x80) {
+        m_text += input.front();
+        input.remove_prefix(1);
+        break;
+      }
+      // Well-formed sequences are copied as is, while ill-formed ones are
+      // replaced by the replacement character.
+      auto* sequenceStart = input.data();
+      bool legal;
+      char32_t codepoint = Text::toUTF32(input, &legal);
+      if (legal)
+        m_text.append(sequenceStart, input.data() - sequenceStart);
+      else
+        appendCodepoint(codepoint);
+    }
+  }
+}
+
 pylir::Diag::Document::Document(std::string_view input, std::string filename,
                                 pylir::Text::Encoding encoding)
     : m_filename(std::move(filename)) {
   m_encoding = Text::readBOM(input).value_or(encoding);
-  m_text.reserve(input.size());
+  if (m_encoding == Text::Encoding::UTF8) {
+    m_text.reserve(input.size());
+    copyUTF8(input);
+    // + 1 for imaginary newline that does not exist
+    m_lineStarts.push_back(m_text.size() + 1);
+    return;
+  }
+
   auto transcoder = Text::Transcoder<void, char32_t>(input, m_encoding);
   for (auto iter = transcoder.begin(); iter != transcoder.end();) {
     switch (*iter) {
@@ -22,10 +108,30 @@ pylir::Diag::Document::Document(std::string_view input, std::string filename,
       std::advance(iter, increment);
       break;
     }
-    case '\n': m_lineStarts.push_back(m_text.size() + 1); [[fallthrough]];
-    default: m_text += *iter++;
+    case '\n':
+      m_text += '\n';
+      m_lineStarts.push_back(m_text.size());
+      iter++;
+      break;
+    default: appendCodepoint(*iter++);
     }
   }
   // + 1 for imaginary newline that does not exist
   m_lineStarts.push_back(m_text.size() + 1);
 }
+
+std::size_t pylir::Diag::Document::countCodepoints(std::size_t begin,
+                                                   std::size_t end) const {
+  std::size_t pastEnd = 0;
+  if (end > m_text.size()) {
+    pastEnd = end - std::max(begin, m_text.size());
+    end = m_text.size();
+  }
+  begin = std::min(begin, end);
+  // Every byte that is not a continuation byte starts a new codepoint.
+  return pastEnd + std::count_if(m_text.begin() + begin, m_text.begin() + end,
+                                 [](char byte) {
+                                   return (static_cast<unsigned char>(byte) &
+                                           0xC0) != 0x80;
+                                 });
+}
@@ -8,24 +8,116 @@
 #include <pylir/Support/Text.hpp>
 
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <tcb/span.hpp>
 
 namespace pylir::Diag {
+/// Source text of a single file. The text is stored as UTF-8 with all line
+/// endings normalized to '\n', regardless of the encoding of the input.
+/// Offsets into a document, as used by tokens and diagnostics, are byte offsets
+/// into this UTF-8 text. Codepoints are only decoded when iterating.
 class Document {
   std::string m_filename;
   Text::Encoding m_encoding;
-  std::u32string m_text;
+  std::string m_text;
   std::vector<std::size_t> m_lineStarts{0};
 
+  /// Copies the UTF-8 encoded 'input' into 'm_text' while normalizing line
+  /// endings, replacing ill-formed sequences and recording the start of every
+  /// line.
+  void copyUTF8(std::string_view input);
+
+  /// Appends 'codepoint' encoded as UTF-8 to 'm_text'.
+  void appendCodepoint(char32_t codepoint);
+
 public:
+  /// Bidirectional iterator over the codepoints of the document. ASCII
+  /// characters are returned as is while any other codepoint is decoded on
+  /// dereference. The difference between two iterators is the distance in
+  /// bytes, making it directly usable as an offset.
+  class const_iterator {
+    const char* m_pos = nullptr;
+
+    static std::size_t sequenceLength(unsigned char lead) {
+      if (lead < 0x80)
+        return 1;
+      if (lead < 0xE0)
+        return 2;
+      if (lead < 0xF0)
+        return 3;
+      return 4;
+    }
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = char32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = char32_t;
+
+    const_iterator() = default;
+
+    explicit const_iterator(const char* pos) : m_pos(pos) {}
+
+    char32_t operator*() const {
+      auto lead = static_cast<unsigned char>(*m_pos);
+      if (lead < 0x80)
+        return lead;
+
+      std::string_view sequence(m_pos, sequenceLength(lead));
+      return Text::toUTF32(sequence);
+    }
+
+    const_iterator& operator++() {
+      m_pos += sequenceLength(static_cast<unsigned char>(*m_pos));
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    const_iterator& operator--() {
+      do
+        m_pos--;
+      while ((static_cast<unsigned char>(*m_pos) & 0xC0) == 0x80);
+      return *this;
+    }
+
+    const_iterator operator--(int) {
+      auto copy = *this;
+      --(*this);
+      return copy;
+    }
+
+    friend difference_type operator-(const_iterator lhs, const_iterator rhs) {
+      return lhs.m_pos - rhs.m_pos;
+    }
+
+    friend bool operator==(const_iterator lhs, const_iterator rhs) {
+      return lhs.m_pos == rhs.m_pos;
+    }
+
+    friend bool operator!=(const_iterator lhs, const_iterator rhs) {
+      return lhs.m_pos != rhs.m_pos;
+    }
+
+    /// Returns a pointer to the first byte of the codepoint.
+    [[nodiscard]] const char* data() const {
+      return m_pos;
+    }
+  };
+
   using value_type = char32_t;
-  using reference = const char32_t&;
-  using const_reference = const char32_t&;
-  using iterator = const char32_t*;
-  using const_iterator = iterator;
+  using reference = char32_t;
+  using const_reference = char32_t;
+  using iterator = const_iterator;
   using difference_type = std::ptrdiff_t;
   using size_type = std::size_t;
 
@@ -33,7 +125,7 @@ public:
                     Text::Encoding encoding = Text::Encoding::UTF8);
 
   [[nodiscard]] iterator begin() const {
-    return m_text.data();
+    return iterator(m_text.data());
   }
 
   [[nodiscard]] const_iterator cbegin() const {
@@ -41,7 +133,7 @@ public:
   }
 
   [[nodiscard]] iterator end() const {
-    return m_text.data() + m_text.size();
+    return iterator(m_text.data() + m_text.size());
   }
 
   [[nodiscard]] const_iterator cend() const {
@@ -57,19 +149,27 @@ public:
     return result - m_lineStarts.begin();
   }
 
+  /// Returns the amount of codepoints whose first byte lies within the byte
+  /// offsets ['begin', 'end'). Offsets past the end of the text count as one
+  /// codepoint each.
+  [[nodiscard]] std::size_t countCodepoints(std::size_t begin,
+                                            std::size_t end) const;
+
+  /// Returns the column of 'offset' within its line. Columns are counted in
+  /// codepoints, starting at 1.
   [[nodiscard]] std::size_t getColNumber(std::size_t offset) const {
-    auto lineNumber = getLineNumber(offset);
-    return offset - m_lineStarts[lineNumber - 1] + 1;
+    return getLineCol(offset).second;
   }
 
   [[nodiscard]] std::pair<std::size_t, std::size_t>
   getLineCol(std::size_t offset) const {
     auto lineNumber = getLineNumber(offset);
-    return {lineNumber, offset - m_lineStarts[lineNumber - 1] + 1};
+    return {lineNumber,
+            countCodepoints(m_lineStarts[lineNumber - 1], offset) + 1};
   }
 
-  [[nodiscard]] std::u32string_view getLine(std::size_t lineNumber) const {
-    return std::u32string_view(m_text).substr(
+  [[nodiscard]] std::string_view getLine(std::size_t lineNumber) const {
+    return std::string_view(m_text).substr(
         m_lineStarts[lineNumber - 1],
         m_lineStarts[lineNumber] - m_lineStarts[lineNumber - 1] - 1);
   }
@@ -82,10 +182,16 @@ public:
     return m_lineStarts;
   }
 
-  [[nodiscard]] std::u32string_view getText() const {
+  [[nodiscard]] std::string_view getText() const {
     return m_text;
   }
 
+  /// Returns the UTF-8 text between the iterators 'begin' and 'end'.
+  [[nodiscard]] std::string_view getText(const_iterator begin,
+                                         const_iterator end) const {
+    return {begin.data(), static_cast<std::size_t>(end - begin)};
+  }
+
   [[nodiscard]] std::string_view getFilename() const {
     return m_filename;
   }
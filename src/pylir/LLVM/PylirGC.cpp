@@ -5,11 +5,17 @@
 #include "PylirGC.hpp"
 
 #include <llvm/ADT/SetVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringSwitch.h>
 #include <llvm/CodeGen/AsmPrinter.h>
 #include <llvm/CodeGen/GCMetadataPrinter.h>
+#include <llvm/CodeGen/MachineModuleInfo.h>
 #include <llvm/CodeGen/StackMaps.h>
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Module.h>
 #include <llvm/MC/MCContext.h>
 #include <llvm/MC/MCObjectFileInfo.h>
 #include <llvm/MC/MCStreamer.h>
@@ -26,6 +32,37 @@ namespace {
 llvm::cl::opt<bool> emitStackMap("pylir-emit-stackmap", llvm::cl::Hidden,
                                  llvm::cl::init(true));
 
+/// Named metadata containing the index of a partition of a split module as its
+/// first operand. Named metadata is used instead of a module flag, as it
+/// survives ThinLTO importing functions from other partitions.
+constexpr llvm::StringLiteral PARTITION_METADATA = "pylir.gc.partition";
+
+/// Magic of a stack map: 'PYLR' as uint32_t.
+constexpr std::uint32_t STACK_MAP_MAGIC = 0x50594C52;
+
+/// Magic of a table of stack maps: 'PYLT' as uint32_t.
+constexpr std::uint32_t STACK_MAP_TABLE_MAGIC = 0x50594C54;
+
+/// Returns the name of the stack map emitted by the partition 'partition'.
+std::string getStackMapName(std::optional<unsigned> partition) {
+  if (!partition)
+    return "pylir_stack_map";
+  return "pylir_stack_map$" + std::to_string(*partition);
+}
+
+/// Returns the partition index of 'module' or an empty optional if 'module' is
+/// not a partition of a split module.
+std::optional<unsigned> getPartition(const llvm::Module& module) {
+  const llvm::NamedMDNode* metadata =
+      module.getNamedMetadata(PARTITION_METADATA);
+  if (!metadata || metadata->getNumOperands() == 0)
+    return std::nullopt;
+
+  auto* index = llvm::mdconst::extract<llvm::ConstantInt>(
+      metadata->getOperand(0)->getOperand(0));
+  return index->getZExtValue();
+}
+
 class PylirGCStrategy final : public llvm::GCStrategy {
 public:
   PylirGCStrategy() {
@@ -65,16 +102,16 @@ class PylirGCMetaDataPrinter final : public llvm::GCMetadataPrinter {
 
   /// Writes out the stack map in our custom format. See pylir/Runtime/Stack.cpp
   /// for details of the format.
-  void writeStackMap(llvm::StackMaps& stackMaps, llvm::AsmPrinter& printer) {
+  void writeStackMap(llvm::StackMaps& stackMaps, llvm::AsmPrinter& printer,
+                     std::optional<unsigned> partition) {
     llvm::MCContext& context = printer.OutContext;
     auto& os = *printer.OutStreamer;
 
-    auto* symbol = printer.GetExternalSymbolSymbol("pylir_stack_map");
+    auto* symbol = printer.GetExternalSymbolSymbol(getStackMapName(partition));
     os.emitSymbolAttribute(symbol, llvm::MCSA_Global);
     switchToPointerAlignedReadOnly(os, printer);
     os.emitLabel(symbol);
-    // File magic 'PYLR' as uint32_t
-    os.emitInt32(0x50594C52);
+    os.emitInt32(STACK_MAP_MAGIC);
 
     auto stackMapLocComp = [](const llvm::StackMaps::Location& lhs,
                               const llvm::StackMaps::Location& rhs) {
@@ -265,8 +302,12 @@ public:
       // explicitly do not want one.
       return true;
     }
-    writeStackMap(stackMaps, printer);
-    writeGlobalMap(printer);
+    // The global maps of a split module are already part of the IR. See
+    // 'prepareGCPartitioning'.
+    std::optional<unsigned> partition = getPartition(*printer.MMI->getModule());
+    writeStackMap(stackMaps, printer, partition);
+    if (!partition)
+      writeGlobalMap(printer);
     return true;
   }
 };
@@ -278,3 +319,112 @@ llvm::GCMetadataPrinterRegistry::Add<PylirGCMetaDataPrinter>
 } // namespace
 
 void pylir::linkInGCStrategy() {}
+
+void pylir::prepareGCPartitioning(llvm::Module& module,
+                                  unsigned partitionCount) {
+  llvm::LLVMContext& context = module.getContext();
+  auto* ptrType = llvm::PointerType::getUnqual(context);
+  auto* i32 = llvm::Type::getInt32Ty(context);
+
+  // Partitions are unable to see the globals of other partitions. Create the
+  // global maps as IR instead, with the same layout as 'writeGlobalMap'.
+  llvm::StringMap<std::vector<llvm::GlobalVariable*>> maps;
+  for (llvm::GlobalVariable& global : module.globals()) {
+    if (global.isDeclaration() || !global.hasSection())
+      continue;
+
+    // Mach-O sections are prefixed with their segment.
+    llvm::StringRef section = global.getSection();
+    section = section.substr(section.rfind(',') + 1);
+    llvm::StringRef name = llvm::StringSwitch<llvm::StringRef>(section)
+                               .Case("py_root", "roots")
+                               .Case("py_const", "constants")
+                               .Case("py_coll", "collections")
+                               .Default("");
+    if (!name.empty())
+      maps[name].push_back(&global);
+  }
+
+  for (llvm::StringRef name : {"roots", "constants", "collections"}) {
+    std::vector<llvm::GlobalVariable*>& globals = maps[name];
+    llvm::sort(globals,
+               [](llvm::GlobalVariable* lhs, llvm::GlobalVariable* rhs) {
+                 return lhs->getName() < rhs->getName();
+               });
+
+    auto* arrayType = llvm::ArrayType::get(ptrType, globals.size());
+    llvm::SmallVector<llvm::Constant*> elements;
+    for (llvm::GlobalVariable* global : globals)
+      elements.push_back(llvm::ConstantExpr::getPointerBitCastOrAddrSpaceCast(
+          global, ptrType));
+
+    auto* array = new llvm::GlobalVariable(
+        module, arrayType, /*isConstant=*/true,
+        llvm::GlobalValue::PrivateLinkage,
+        llvm::ConstantArray::get(arrayType, elements), "pylir$" + name);
+    new llvm::GlobalVariable(module, ptrType, /*isConstant=*/true,
+                             llvm::GlobalValue::ExternalLinkage, array,
+                             "pylir_" + name + "_start");
+    new llvm::GlobalVariable(
+        module, ptrType, /*isConstant=*/true,
+        llvm::GlobalValue::ExternalLinkage,
+        llvm::ConstantExpr::getGetElementPtr(arrayType, array,
+                                             llvm::ConstantInt::get(i32, 1)),
+        "pylir_" + name + "_end");
+  }
+
+  // Table of all stack maps of the partitions, which are emitted by each
+  // partition. See pylir/Runtime/GC/Stack.cpp for the format.
+  auto* tableArrayType = llvm::ArrayType::get(ptrType, partitionCount);
+  llvm::SmallVector<llvm::Constant*> stackMaps;
+  for (unsigned i = 0; i < partitionCount; i++)
+    stackMaps.push_back(new llvm::GlobalVariable(
+        module, llvm::Type::getInt8Ty(context), /*isConstant=*/true,
+        llvm::GlobalValue::ExternalLinkage, nullptr, getStackMapName(i)));
+
+  auto* tableType = llvm::StructType::get(i32, i32, tableArrayType);
+  new llvm::GlobalVariable(
+      module, tableType, /*isConstant=*/true,
+      llvm::GlobalValue::ExternalLinkage,
+      llvm::ConstantStruct::get(
+          tableType, {llvm::ConstantInt::get(i32, STACK_MAP_TABLE_MAGIC),
+                      llvm::ConstantInt::get(i32, partitionCount),
+                      llvm::ConstantArray::get(tableArrayType, stackMaps)}),
+      getStackMapName(std::nullopt));
+}
+
+void pylir::setGCPartition(llvm::Module& partition, unsigned index) {
+  llvm::LLVMContext& context = partition.getContext();
+  partition.getOrInsertNamedMetadata(PARTITION_METADATA)
+      ->addOperand(llvm::MDNode::get(
+          context, llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(
+                       llvm::Type::getInt32Ty(context), index))));
+
+  // The stack map is only emitted by partitions containing functions using
+  // the GC. Any other partition needs an empty stack map for the table to
+  // refer to.
+  if (llvm::any_of(partition.functions(), [](const llvm::Function& function) {
+        return !function.isDeclaration() && function.hasGC() &&
+               function.getGC() == "pylir-gc";
+      }))
+    return;
+
+  auto* i8 = llvm::Type::getInt8Ty(context);
+  auto* i32 = llvm::Type::getInt32Ty(context);
+  auto* stackMapType = llvm::StructType::get(context, {i32, i8, i8},
+                                             /*isPacked=*/true);
+  // Magic followed by zero reference locations and zero call sites.
+  auto* stackMap = new llvm::GlobalVariable(
+      partition, stackMapType, /*isConstant=*/true,
+      llvm::GlobalValue::ExternalLinkage,
+      llvm::ConstantStruct::get(stackMapType,
+                                {llvm::ConstantInt::get(i32, STACK_MAP_MAGIC),
+                                 llvm::ConstantInt::get(i8, 0),
+                                 llvm::ConstantInt::get(i8, 0)}));
+  std::string name = getStackMapName(index);
+  if (llvm::GlobalVariable* declaration = partition.getNamedGlobal(name)) {
+    declaration->replaceAllUsesWith(stackMap);
+    declaration->eraseFromParent();
+  }
+  stackMap->setName(name);
+}
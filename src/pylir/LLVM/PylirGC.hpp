@@ -5,7 +5,18 @@
 #pragma once
 
 #include <llvm/IR/GCStrategy.h>
+#include <llvm/IR/Module.h>
 
 namespace pylir {
 void linkInGCStrategy();
+
+/// Prepares 'module' to be split into 'partitionCount' modules which are
+/// compiled separately. Every partition emits its own stack map while the
+/// global maps and a table of all stack maps are added to 'module' as IR.
+/// This has to be called prior to splitting the module.
+void prepareGCPartitioning(llvm::Module& module, unsigned partitionCount);
+
+/// Marks 'partition' as the partition with the index 'index' of a module
+/// previously prepared with 'prepareGCPartitioning'.
+void setGCPartition(llvm::Module& partition, unsigned index);
 } // namespace pylir
@@ -10,11 +10,12 @@
 #include <pylir/Diagnostics/DiagnosticsBuilder.hpp>
 #include <pylir/Support/Util.hpp>
 
+#include <array>
 #include <charconv>
 #include <functional>
 #include <iterator>
 #include <locale>
-#include <unordered_map>
+#include <stdexcept>
 
 pylir::Lexer::Lexer(Diag::DiagnosticsDocManager<>& diagManager)
     : m_current(diagManager.getDocument().begin()),
@@ -476,11 +477,6 @@ constexpr llvm::sys::UnicodeCharRange LEGAL_IDENTIFIERS[] = {
 };
 #pragma endregion
 
-bool isBlankLineSoFar(llvm::ArrayRef<pylir::Token> tokens) {
-  return tokens.empty() ||
-         tokens.back().getTokenType() == pylir::TokenType::Newline;
-}
-
 } // namespace
 
 bool pylir::Lexer::parseNext() {
@@ -489,7 +485,7 @@ bool pylir::Lexer::parseNext() {
 
   std::size_t startSize = m_tokens.size();
   do {
-    const auto* start = m_current;
+    auto start = m_current;
     switch (*m_current) {
     case U'#':
       m_current = std::find_if(m_current, m_diagManager->getDocument().end(),
@@ -505,7 +501,8 @@ bool pylir::Lexer::parseNext() {
         // Skip over blank logical lines. If the last token before the comment
         // was a newline, or we have no tokens, as this is file begin, no
         // newline tokens are generated because the whole lines was blank
-        if (!isBlankLineSoFar(m_tokens))
+        if (!m_tokens.empty() &&
+            m_tokens.back().getTokenType() != TokenType::Newline)
           m_tokens.emplace_back(offset, 1, TokenType::Newline);
 
         parseIndent();
@@ -879,73 +876,135 @@ bool pylir::Lexer::parseNext() {
   return true;
 }
 
+namespace {
+
+constexpr std::size_t KEYWORD_TABLE_SIZE = 128;
+
+/// Perfect hash for all keywords of python. Only looks at the length, first and
+/// last character of an identifier. All keywords have a unique hash within
+/// 'KEYWORD_TABLE_SIZE'.
+constexpr std::size_t hashKeyword(std::string_view identifier) {
+  return (identifier.size() + static_cast<unsigned char>(identifier.front()) +
+          11 * static_cast<unsigned char>(identifier.back())) %
+         KEYWORD_TABLE_SIZE;
+}
+
+struct KeywordEntry {
+  std::string_view keyword;
+  pylir::TokenType tokenType = pylir::TokenType::Identifier;
+};
+
+constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE>
+createKeywordTable(std::initializer_list<KeywordEntry> keywords) {
+  std::array<KeywordEntry, KEYWORD_TABLE_SIZE> table{};
+  for (const KeywordEntry& entry : keywords) {
+    KeywordEntry& slot = table[hashKeyword(entry.keyword)];
+    // Not a constant expression if two keywords have the same hash, making
+    // this a compilation error.
+    if (!slot.keyword.empty())
+      throw std::logic_error("keyword hash collision");
+    slot = entry;
+  }
+  return table;
+}
+
+constexpr auto KEYWORD_TABLE = createKeywordTable({
+    {"False", pylir::TokenType::FalseKeyword},
+    {"None", pylir::TokenType::NoneKeyword},
+    {"True", pylir::TokenType::TrueKeyword},
+    {"and", pylir::TokenType::AndKeyword},
+    {"as", pylir::TokenType::AsKeyword},
+    {"assert", pylir::TokenType::AssertKeyword},
+    {"async", pylir::TokenType::AsyncKeyword},
+    {"await", pylir::TokenType::AwaitKeyword},
+    {"break", pylir::TokenType::BreakKeyword},
+    {"class", pylir::TokenType::ClassKeyword},
+    {"continue", pylir::TokenType::ContinueKeyword},
+    {"def", pylir::TokenType::DefKeyword},
+    {"del", pylir::TokenType::DelKeyword},
+    {"elif", pylir::TokenType::ElifKeyword},
+    {"else", pylir::TokenType::ElseKeyword},
+    {"except", pylir::TokenType::ExceptKeyword},
+    {"finally", pylir::TokenType::FinallyKeyword},
+    {"for", pylir::TokenType::ForKeyword},
+    {"from", pylir::TokenType::FromKeyword},
+    {"global", pylir::TokenType::GlobalKeyword},
+    {"if", pylir::TokenType::IfKeyword},
+    {"import", pylir::TokenType::ImportKeyword},
+    {"in", pylir::TokenType::InKeyword},
+    {"is", pylir::TokenType::IsKeyword},
+    {"lambda", pylir::TokenType::LambdaKeyword},
+    {"nonlocal", pylir::TokenType::NonlocalKeyword},
+    {"not", pylir::TokenType::NotKeyword},
+    {"or", pylir::TokenType::OrKeyword},
+    {"pass", pylir::TokenType::PassKeyword},
+    {"raise", pylir::TokenType::RaiseKeyword},
+    {"return", pylir::TokenType::ReturnKeyword},
+    {"try", pylir::TokenType::TryKeyword},
+    {"while", pylir::TokenType::WhileKeyword},
+    {"with", pylir::TokenType::WithKeyword},
+    {"yield", pylir::TokenType::YieldKeyword},
+});
+
+/// Returns the token type of the keyword 'identifier' or 'Identifier' if it is
+/// not a keyword.
+pylir::TokenType lookupKeyword(std::string_view identifier) {
+  const KeywordEntry& entry = KEYWORD_TABLE[hashKeyword(identifier)];
+  if (entry.keyword != identifier)
+    return pylir::TokenType::Identifier;
+  return entry.tokenType;
+}
+
+bool isASCIIIdentifierCharacter(char32_t value) {
+  return (value >= U'a' && value <= U'z') || (value >= U'A' && value <= U'Z') ||
+         (value >= U'0' && value <= U'9') || value == U'_';
+}
+
+} // namespace
+
 void pylir::Lexer::parseIdentifier() {
   static auto initialCharacterSet =
       llvm::sys::UnicodeCharSet(INITIAL_CHARACTERS);
   if (!initialCharacterSet.contains(*m_current)) {
-    createError(m_current - m_diagManager->getDocument().begin(),
-                Diag::UNEXPECTED_CHARACTER_N,
-                Text::toUTF8String({&*m_current, 1}))
+    auto next = std::next(m_current);
+    createError(
+        m_current - m_diagManager->getDocument().begin(),
+        Diag::UNEXPECTED_CHARACTER_N,
+        std::string(m_diagManager->getDocument().getText(m_current, next)))
         .addHighlight(m_current - m_diagManager->getDocument().begin());
-    m_tokens.emplace_back(m_current - m_diagManager->getDocument().begin(), 1,
-                          TokenType::SyntaxError);
-    m_current++;
+    m_tokens.emplace_back(m_current - m_diagManager->getDocument().begin(),
+                          next - m_current, TokenType::SyntaxError);
+    m_current = next;
     return;
   }
   static auto legalIdentifierSet = llvm::sys::UnicodeCharSet(LEGAL_IDENTIFIERS);
-  const auto* start = m_current;
+  auto start = m_current;
+  // Identifiers consist almost exclusively of ASCII characters, which are
+  // checked without having to search through the unicode ranges.
+  bool isASCII = true;
   m_current = std::find_if_not(
-      m_current, m_diagManager->getDocument().end(),
-      [&](char32_t value) { return legalIdentifierSet.contains(value); });
-  auto utf32 =
-      std::u32string_view{start, static_cast<std::size_t>(m_current - start)};
-  static std::unordered_map<std::u32string_view, TokenType> keywords = {
-      {U"False", TokenType::FalseKeyword},
-      {U"None", TokenType::NoneKeyword},
-      {U"True", TokenType::TrueKeyword},
-      {U"and", TokenType::AndKeyword},
-      {U"as", TokenType::AsKeyword},
-      {U"assert", TokenType::AssertKeyword},
-      {U"async", TokenType::AsyncKeyword},
-      {U"await", TokenType::AwaitKeyword},
-      {U"break", TokenType::BreakKeyword},
-      {U"class", TokenType::ClassKeyword},
-      {U"continue", TokenType::ContinueKeyword},
-      {U"def", TokenType::DefKeyword},
-      {U"del", TokenType::DelKeyword},
-      {U"elif", TokenType::ElifKeyword},
-      {U"else", TokenType::ElseKeyword},
-      {U"except", TokenType::ExceptKeyword},
-      {U"finally", TokenType::FinallyKeyword},
-      {U"for", TokenType::ForKeyword},
-      {U"from", TokenType::FromKeyword},
-      {U"global", TokenType::GlobalKeyword},
-      {U"if", TokenType::IfKeyword},
-      {U"import", TokenType::ImportKeyword},
-      {U"in", TokenType::InKeyword},
-      {U"is", TokenType::IsKeyword},
-      {U"lambda", TokenType::LambdaKeyword},
-      {U"nonlocal", TokenType::NonlocalKeyword},
-      {U"not", TokenType::NotKeyword},
-      {U"or", TokenType::OrKeyword},
-      {U"pass", TokenType::PassKeyword},
-      {U"raise", TokenType::RaiseKeyword},
-      {U"return", TokenType::ReturnKeyword},
-      {U"try", TokenType::TryKeyword},
-      {U"while", TokenType::WhileKeyword},
-      {U"with", TokenType::WithKeyword},
-      {U"yield", TokenType::YieldKeyword},
-  };
-  if (auto result = keywords.find(utf32); result != keywords.end()) {
+      m_current, m_diagManager->getDocument().end(), [&](char32_t value) {
+        if (isASCIIIdentifierCharacter(value))
+          return true;
+        if (value < 0x80)
+          return false;
+        isASCII = false;
+        return legalIdentifierSet.contains(value);
+      });
+  auto identifier = m_diagManager->getDocument().getText(start, m_current);
+  if (TokenType keyword = lookupKeyword(identifier);
+      keyword != TokenType::Identifier) {
     m_tokens.emplace_back(start - m_diagManager->getDocument().begin(),
-                          m_current - start, result->second);
+                          m_current - start, keyword);
     return;
   }
 
-  auto normalized = Text::normalize(utf32, Text::Normalization::NFKC);
-  [[maybe_unused]] bool ok;
-  auto utf8 = Text::toUTF8String(normalized, &ok);
-  PYLIR_ASSERT(ok);
+  // ASCII identifiers are already in NFKC form and can be copied directly.
+  std::string utf8;
+  if (isASCII)
+    utf8 = identifier;
+  else
+    utf8 = Text::normalize(identifier, Text::Normalization::NFKC);
   m_tokens.emplace_back(start - m_diagManager->getDocument().begin(),
                         m_current - start, TokenType::Identifier,
                         std::move(utf8));
@@ -1067,7 +1126,8 @@ std::optional<std::string> pylir::Lexer::parseLiteral(bool raw, bool bytes) {
     if (raw)
       return;
 
-    std::string utf8Bytes = Text::toUTF8(*m_current).data();
+    auto utf8Bytes = m_diagManager->getDocument().getText(
+        m_current, std::next(m_current));
     std::string hexEscape;
     for (auto iter : utf8Bytes) {
       hexEscape += fmt::format(
@@ -1130,7 +1190,9 @@ std::optional<std::string> pylir::Lexer::parseLiteral(bool raw, bool bytes) {
                count != sizeof("ewline") - 1)
           count++;
 
-        if (std::u32string_view(std::prev(m_current), count + 1) == U"newline")
+        if (m_diagManager->getDocument().getText(
+                std::prev(m_current), std::next(m_current, count)) ==
+            "newline")
           std::advance(m_current, count);
 
         break;
@@ -1259,10 +1321,10 @@ std::optional<std::string> pylir::Lexer::parseLiteral(bool raw, bool bytes) {
           return std::nullopt;
         }
         m_current++;
-        const auto* closing =
+        auto closing =
             std::find(m_current, m_diagManager->getDocument().end(), U'}');
-        auto utf8Name = Text::toUTF8String(std::u32string_view{
-            m_current, static_cast<std::size_t>(closing - m_current)});
+        auto utf8Name = std::string(
+            m_diagManager->getDocument().getText(m_current, closing));
         auto codepoint = Text::fromName(utf8Name);
         if (!codepoint) {
           auto builder =
@@ -1333,7 +1395,7 @@ std::optional<std::string> pylir::Lexer::parseLiteral(bool raw, bool bytes) {
 }
 
 void pylir::Lexer::parseNumber() {
-  const auto* start = m_current;
+  auto start = m_current;
   PYLIR_ASSERT(m_current != m_diagManager->getDocument().end());
   bool (*allowedDigits)(char32_t) =
       +[](char32_t value) { return value >= U'0' && value <= U'9'; };
@@ -1381,8 +1443,8 @@ void pylir::Lexer::parseNumber() {
     default: break;
     }
   }
-  const auto* numberStart = m_current;
-  const auto* end =
+  auto numberStart = m_current;
+  auto end =
       std::find_if_not(m_current, m_diagManager->getDocument().end(),
                        [allowedDigits, previous = U'\0', &isFloat,
                         radix](char32_t value) mutable {
@@ -1407,7 +1469,7 @@ void pylir::Lexer::parseNumber() {
   if (*std::prev(end) == U'_') {
     createError(end - m_diagManager->getDocument().begin() - 1,
                 Diag::UNDERSCORE_ONLY_ALLOWED_BETWEEN_DIGITS)
-        .addHighlight(end - 1 - m_diagManager->getDocument().begin())
+        .addHighlight(end - m_diagManager->getDocument().begin() - 1)
         .addHighlight(start - m_diagManager->getDocument().begin(),
                       end - m_diagManager->getDocument().begin() - 2,
                       Diag::flags::secondaryColour);
@@ -1416,15 +1478,14 @@ void pylir::Lexer::parseNumber() {
     return;
   }
   std::string text;
-  for (auto codepoint : std::u32string_view{
-           numberStart, static_cast<std::size_t>(end - numberStart)})
-    if (codepoint != U'_')
-      text += codepoint;
+  for (char digit : m_diagManager->getDocument().getText(numberStart, end))
+    if (digit != '_')
+      text += digit;
 
   auto checkSuffix = [&] {
     static auto legalIdentifierSet =
         llvm::sys::UnicodeCharSet(LEGAL_IDENTIFIERS);
-    const auto* suffixEnd = std::find_if_not(
+    auto suffixEnd = std::find_if_not(
         m_current, m_diagManager->getDocument().end(),
         [&](char32_t value) { return legalIdentifierSet.contains(value); });
     if (suffixEnd == m_current)
@@ -1432,8 +1493,8 @@ void pylir::Lexer::parseNumber() {
 
     createError(m_current - m_diagManager->getDocument().begin(),
                 Diag::INVALID_INTEGER_SUFFIX,
-                Text::toUTF8String({m_current, static_cast<std::size_t>(
-                                                   suffixEnd - m_current)}))
+                std::string(m_diagManager->getDocument().getText(m_current,
+                                                                 suffixEnd)))
         .addHighlight(start - m_diagManager->getDocument().begin(),
                       m_current - m_diagManager->getDocument().begin() - 1,
                       Diag::flags::secondaryColour)
@@ -1458,10 +1519,9 @@ void pylir::Lexer::parseNumber() {
       return;
     }
     if (radix == 10 && !integer.isZero() && text.front() == '0') {
-      const auto* leadingEnd =
-          std::find_if_not(numberStart, end, [](char32_t value) {
-            return value == U'_' || value == U'0';
-          });
+      auto leadingEnd = std::find_if_not(numberStart, end, [](char32_t value) {
+        return value == U'_' || value == U'0';
+      });
 
       createError(end - m_diagManager->getDocument().begin() - 1,
                   Diag::NUMBER_WITH_LEADING_ZEROS_NOT_ALLOWED)
@@ -1499,7 +1559,7 @@ void pylir::Lexer::parseNumber() {
       text += *end;
       end++;
     }
-    const auto* newEnd = std::find_if_not(
+    auto newEnd = std::find_if_not(
         end, m_diagManager->getDocument().end(),
         [previous = U'\0', allowedDigits](char32_t value) mutable {
           if (value == U'_') {
@@ -1524,10 +1584,9 @@ void pylir::Lexer::parseNumber() {
       return;
     }
 
-    for (auto codepoint :
-         std::u32string_view{end, static_cast<std::size_t>(newEnd - end)})
-      if (codepoint != U'_')
-        text += codepoint;
+    for (char digit : m_diagManager->getDocument().getText(end, newEnd))
+      if (digit != '_')
+        text += digit;
   }
 
   double number;
@@ -1571,7 +1630,7 @@ void pylir::Lexer::parseNumber() {
 }
 
 void pylir::Lexer::parseIndent() {
-  const auto* start = m_current;
+  auto start = m_current;
   std::size_t indent = 0;
   for (; m_current != m_diagManager->getDocument().end() &&
          (Text::isWhitespace(*m_current) || *m_current == U'#');
@@ -1590,7 +1649,7 @@ void pylir::Lexer::parseIndent() {
     }
   }
   if (indent < m_indentation.top().first) {
-    std::pair<std::size_t, std::size_t> previous;
+    std::pair<std::size_t, BaseToken> previous = m_indentation.top();
     do {
       m_tokens.emplace_back(start - m_diagManager->getDocument().begin(),
                             start - m_diagManager->getDocument().begin(),
@@ -1608,15 +1667,15 @@ void pylir::Lexer::parseIndent() {
                                 1);
       if (previous.first - indent < indent - m_indentation.top().first) {
         builder
-            .addNote(m_tokens[previous.second],
-                     Diag::NEXT_CLOSEST_INDENTATION_N, previous.first)
-            .addHighlight(m_tokens[previous.second]);
+            .addNote(previous.second, Diag::NEXT_CLOSEST_INDENTATION_N,
+                     previous.first)
+            .addHighlight(previous.second);
       } else if (m_indentation.top().first != 0) {
         builder
-            .addNote(m_tokens[m_indentation.top().second],
+            .addNote(m_indentation.top().second,
                      Diag::NEXT_CLOSEST_INDENTATION_N,
                      m_indentation.top().first)
-            .addHighlight(m_tokens[m_indentation.top().second]);
+            .addHighlight(m_indentation.top().second);
       }
       m_tokens.emplace_back(start - m_diagManager->getDocument().begin(),
                             m_current - start, TokenType::SyntaxError);
@@ -1624,6 +1683,6 @@ void pylir::Lexer::parseIndent() {
   } else if (indent > m_indentation.top().first) {
     m_tokens.emplace_back(start - m_diagManager->getDocument().begin(),
                           m_current - start, TokenType::Indent);
-    m_indentation.emplace(indent, m_tokens.size() - 1);
+    m_indentation.emplace(indent, m_tokens.back());
   }
 }
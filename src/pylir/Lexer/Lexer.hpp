@@ -11,6 +11,7 @@
 #include <pylir/Support/Text.hpp>
 
 #include <cstdint>
+#include <deque>
 #include <optional>
 #include <stack>
 #include <string_view>
@@ -20,12 +21,49 @@
 
 namespace pylir {
 class Lexer {
-  std::vector<Token> m_tokens;
+  /// Tokens produced by the lexer that have not yet been discarded. Tokens are
+  /// indexed by their position within the whole token stream.
+  class TokenWindow {
+    std::deque<Token> m_tokens;
+    std::size_t m_discarded = 0;
+
+  public:
+    const Token& operator[](std::size_t index) const {
+      PYLIR_ASSERT(index >= m_discarded);
+      return m_tokens[index - m_discarded];
+    }
+
+    [[nodiscard]] std::size_t size() const {
+      return m_discarded + m_tokens.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+      return size() == 0;
+    }
+
+    [[nodiscard]] const Token& back() const {
+      return m_tokens.back();
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+      m_tokens.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// Releases all tokens prior to 'index'. The last token is always kept as
+    /// it is required to lex the next token.
+    void discardBefore(std::size_t index) {
+      for (; m_discarded < index && m_tokens.size() > 1; m_discarded++)
+        m_tokens.pop_front();
+    }
+  };
+
+  TokenWindow m_tokens;
   Diag::Document::const_iterator m_current;
   Diag::DiagnosticsDocManager<>* m_diagManager;
   std::size_t m_depth = 0;
-  std::stack<std::pair<std::size_t, std::size_t>> m_indentation{
-      {{0, static_cast<std::size_t>(-1)}}};
+  std::stack<std::pair<std::size_t, BaseToken>> m_indentation{
+      {{0, BaseToken(0, 0)}}};
 
   bool parseNext();
 
@@ -81,6 +119,17 @@ public:
                                     std::forward<Args>(args)...);
   }
 
+  /// Releases all tokens prior to 'iter'. Any iterators pointing to these
+  /// tokens may no longer be dereferenced. Used by consumers of the token
+  /// stream to only keep the tokens alive that they may still look at.
+  void discardTokensBefore(const iterator& iter) {
+    if (iter == end()) {
+      m_tokens.discardBefore(m_tokens.size());
+      return;
+    }
+    m_tokens.discardBefore(iter - begin());
+  }
+
   [[nodiscard]] Diag::DiagnosticsDocManager<>& getDiagManager() const {
     return *m_diagManager;
   }
@@ -16,6 +16,7 @@
 #include <mlir/IR/Verifier.h>
 #include <mlir/Parser/Parser.h>
 #include <mlir/Pass/Pass.h>
+#include <mlir/Pass/PassInstrumentation.h>
 #include <mlir/Pass/PassManager.h>
 #include <mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h>
 #include <mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h>
@@ -23,9 +24,14 @@
 #include <mlir/Transforms/Passes.h>
 
 #include <llvm/ADT/ScopeExit.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringSet.h>
 #include <llvm/Analysis/AliasAnalysis.h>
 #include <llvm/Analysis/GlobalsModRef.h>
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
+#include <llvm/Analysis/ProfileSummaryInfo.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Bitcode/BitcodeWriterPass.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IRPrinter/IRPrintingPasses.h>
@@ -33,14 +39,17 @@
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
+#include <llvm/Support/BLAKE3.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/Program.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/TimeProfiler.h>
 #include <llvm/Transforms/Instrumentation/AddressSanitizer.h>
 #include <llvm/Transforms/Instrumentation/ThreadSanitizer.h>
 #include <llvm/Transforms/Scalar/DeadStoreElimination.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
 #include <pylir/CodeGen/CodeGen.hpp>
 #include <pylir/LLVM/PlaceStatepoints.hpp>
@@ -55,6 +64,8 @@
 #include <pylir/Parser/Dumper.hpp>
 #include <pylir/Parser/Parser.hpp>
 
+#include <atomic>
+
 #include "DiagnosticMessages.hpp"
 
 using namespace mlir;
@@ -63,8 +74,8 @@ using namespace pylir::cli;
 namespace {
 bool enableLTO(const pylir::cli::CommandLine& commandLine) {
   const auto& args = commandLine.getArgs();
-  if (args.hasFlag(OPT_flto, OPT_fno_lto, false))
-    return true;
+  if (auto* arg = args.getLastArg(OPT_flto, OPT_flto_EQ, OPT_fno_lto))
+    return !arg->getOption().matches(OPT_fno_lto);
 
   // --lld-path overrides -f[no-]integrated-lld unconditionally. If the embedded
   // lld is used and -O4 enable LTO
@@ -83,6 +94,13 @@ bool enableLTO(const pylir::cli::CommandLine& commandLine) {
   return enable;
 }
 
+/// Returns true if LTO, if enabled, should be done using ThinLTO.
+bool useThinLTO(const llvm::opt::InputArgList& args) {
+  auto* arg = args.getLastArg(OPT_flto, OPT_flto_EQ, OPT_fno_lto);
+  return arg && arg->getOption().matches(OPT_flto_EQ) &&
+         arg->getValue() == llvm::StringRef("thin");
+}
+
 // https://cmake.org/cmake/help/latest/command/add_custom_command.html for
 // format
 llvm::SmallString<100> escapeForMakefile(llvm::StringRef filename) {
@@ -172,6 +190,59 @@ void llvmDataLayoutToMLIRDataLayout(mlir::ModuleOp moduleOp,
       mlir::DLTIDialect::kDataLayoutAttrName,
       mlir::DataLayoutSpecAttr::get(moduleOp.getContext(), entries));
 }
+
+std::string getTimeTraceProcessName(const CommandLine& commandLine) {
+  return llvm::sys::path::filename(commandLine.getExecutablePath()).str();
+}
+
+/// Enables the time trace profiler on the current thread for the duration of
+/// a task executed on the thread pool. Does nothing if time tracing is
+/// disabled or the task is executed on a thread that already traces, such as
+/// the main thread.
+class TimeTraceTaskScope {
+  bool m_initialized = false;
+
+public:
+  TimeTraceTaskScope(std::optional<unsigned> granularity,
+                     const CommandLine& commandLine) {
+    if (!granularity || llvm::timeTraceProfilerEnabled())
+      return;
+
+    llvm::timeTraceProfilerInitialize(*granularity,
+                                      getTimeTraceProcessName(commandLine));
+    m_initialized = true;
+  }
+
+  ~TimeTraceTaskScope() {
+    if (m_initialized)
+      llvm::timeTraceProfilerFinishThread();
+  }
+
+  TimeTraceTaskScope(const TimeTraceTaskScope&) = delete;
+  TimeTraceTaskScope& operator=(const TimeTraceTaskScope&) = delete;
+};
+
+/// Records the execution of every MLIR pass in the time trace. The operation
+/// the pass is run on is used as detail if it is a symbol.
+class TimeTraceInstrumentation : public mlir::PassInstrumentation {
+public:
+  void runBeforePass(mlir::Pass* pass, mlir::Operation* op) override {
+    llvm::timeTraceProfilerBegin(pass->getName(), [&]() -> std::string {
+      if (auto symbol = llvm::dyn_cast<mlir::SymbolOpInterface>(op))
+        return symbol.getName().str();
+      return op->getName().getStringRef().str();
+    });
+  }
+
+  void runAfterPass(mlir::Pass*, mlir::Operation*) override {
+    llvm::timeTraceProfilerEnd();
+  }
+
+  void runAfterPassFailed(mlir::Pass*, mlir::Operation*) override {
+    llvm::timeTraceProfilerEnd();
+  }
+};
+
 } // namespace
 
 mlir::LogicalResult pylir::CompilerInvocation::executeAction(
@@ -188,6 +259,64 @@ mlir::LogicalResult pylir::CompilerInvocation::executeAction(
     m_threadPool = std::make_unique<llvm::SingleThreadExecutor>(
         llvm::hardware_concurrency(1));
 
+  if (!args.hasArg(OPT_ftime_trace, OPT_ftime_trace_EQ))
+    return performAction(inputFile, commandLine, toolchain, action,
+                         diagManager);
+
+  unsigned granularity = 500;
+  if (auto* arg = args.getLastArg(OPT_ftime_trace_granularity_EQ);
+      arg && llvm::StringRef(arg->getValue()).getAsInteger(10, granularity)) {
+    commandLine
+        .createError(arg, Diag::INVALID_TIME_TRACE_GRANULARITY_N,
+                     arg->getValue())
+        .addHighlight(arg);
+    return mlir::failure();
+  }
+
+  // The profiler is enabled on the main thread for the whole compilation.
+  // Tasks executed on the thread pool enable it for their own thread.
+  m_timeTraceGranularity = granularity;
+  llvm::timeTraceProfilerInitialize(granularity,
+                                    getTimeTraceProcessName(commandLine));
+  auto cleanup =
+      llvm::make_scope_exit([] { llvm::timeTraceProfilerCleanup(); });
+  mlir::LogicalResult result;
+  {
+    llvm::TimeTraceScope scope("ExecuteCompiler");
+    result =
+        performAction(inputFile, commandLine, toolchain, action, diagManager);
+  }
+  if (mlir::failed(result))
+    return mlir::failure();
+
+  return writeTimeTrace(commandLine);
+}
+
+mlir::LogicalResult
+pylir::CompilerInvocation::writeTimeTrace(CommandLine& commandLine) {
+  const auto& args = commandLine.getArgs();
+  llvm::SmallString<128> path = args.getLastArgValue(OPT_ftime_trace_EQ);
+  if (path.empty()) {
+    path = m_actionOutputFilename;
+    if (path.empty() || path == "-")
+      path = llvm::sys::path::filename(args.getLastArgValue(OPT_INPUT));
+    llvm::sys::path::replace_extension(path, "json");
+  }
+
+  if (llvm::Error error = llvm::timeTraceProfilerWrite(path, path)) {
+    llvm::consumeError(std::move(error));
+    commandLine.createError(Diag::FAILED_TO_WRITE_TIME_TRACE_N, path.str());
+    return mlir::failure();
+  }
+  return mlir::success();
+}
+
+mlir::LogicalResult pylir::CompilerInvocation::performAction(
+    llvm::opt::Arg* inputFile, CommandLine& commandLine,
+    const pylir::Toolchain& toolchain, CompilerInvocation::Action action,
+    Diag::DiagnosticsManager& diagManager) {
+  const auto& args = commandLine.getArgs();
+
   std::optional<llvm::ToolOutputFile> outputFile;
   if (!commandLine.onlyPrint()) {
     if (auto* arg = args.getLastArg(OPT_M)) {
@@ -235,6 +364,13 @@ mlir::LogicalResult pylir::CompilerInvocation::executeAction(
   if (action != Link)
     return finalizeOutputStream(mlir::success(), commandLine);
 
+  // Partition object files are only needed as input to the linker.
+  auto removePartitionObjectFiles = llvm::make_scope_exit([&] {
+    for (const std::string& objectFile : m_partitionObjectFiles)
+      llvm::sys::fs::remove(objectFile);
+    m_partitionObjectFiles.clear();
+  });
+
   if (commandLine.onlyPrint())
     if (mlir::failed(ensureOutputStream(args, action, commandLine)))
       return mlir::failure();
@@ -248,7 +384,13 @@ mlir::LogicalResult pylir::CompilerInvocation::executeAction(
                             m_tempFile->TmpName);
     return mlir::failure();
   }
-  bool success = toolchain.link(commandLine, fileName);
+  std::vector<std::string> objectFiles{fileName};
+  llvm::append_range(objectFiles, m_partitionObjectFiles);
+  bool success;
+  {
+    llvm::TimeTraceScope scope("Link");
+    success = toolchain.link(commandLine, objectFiles);
+  }
   llvm::sys::fs::remove(fileName);
   return mlir::success(success);
 }
@@ -330,7 +472,11 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
   std::unique_ptr<llvm::Module> llvmModule;
   switch (type) {
   case FileType::Python: {
-    auto content = readWholeFile(inputFile, commandLine);
+    FailureOr<std::string> content = failure();
+    {
+      llvm::TimeTraceScope scope("Read", inputFile->getValue());
+      content = readWholeFile(inputFile, commandLine);
+    }
     if (mlir::failed(content))
       return mlir::failure();
 
@@ -338,6 +484,7 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
     auto subDiagManager = diagManager.createSubDiagnosticManager(document);
     Syntax::FileInput* fileInput;
     {
+      llvm::TimeTraceScope scope("Parse", inputFile->getValue());
       pylir::Parser parser(subDiagManager);
       auto tree = parser.parseFileInput();
       if (!tree || subDiagManager.errorsOccurred())
@@ -354,8 +501,12 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
 
     ensureMLIRContext();
 
-    auto module =
-        codegenPythonToMLIR(args, commandLine, diagManager, subDiagManager);
+    FailureOr<OwningOpRef<ModuleOp>> module = failure();
+    {
+      llvm::TimeTraceScope scope("CodeGen");
+      module =
+          codegenPythonToMLIR(args, commandLine, diagManager, subDiagManager);
+    }
     if (mlir::failed(module))
       return mlir::failure();
 
@@ -422,6 +573,9 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
     if (args.hasArg(OPT_Xtiming))
       manager.enableTiming();
 
+    if (m_timeTraceGranularity)
+      manager.addInstrumentation(std::make_unique<TimeTraceInstrumentation>());
+
     bool produceDebugInfo =
         args.getLastArgValue(OPT_g, "0") != llvm::StringRef{"0"};
     if (!produceDebugInfo)
@@ -435,6 +589,7 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
         return mlir::failure();
 
     if (shouldOutput(OPT_emit_pylir)) {
+      llvm::TimeTraceScope scope("MLIR Pipeline");
       if (mlir::failed(manager.run(*mlirModule)))
         return mlir::failure();
 
@@ -467,12 +622,18 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
       manager.printAsTextualPipeline(llvm::errs());
       llvm::errs() << '\n';
     }
-    if (mlir::failed(manager.run(*mlirModule)))
-      return mlir::failure();
+    {
+      llvm::TimeTraceScope scope("MLIR Pipeline");
+      if (mlir::failed(manager.run(*mlirModule)))
+        return mlir::failure();
+    }
 
     mlir::registerLLVMDialectTranslation(*m_mlirContext);
     mlir::registerBuiltinDialectTranslation(*m_mlirContext);
-    llvmModule = mlir::translateModuleToLLVMIR(*mlirModule, *m_llvmContext);
+    {
+      llvm::TimeTraceScope scope("Translate to LLVM IR");
+      llvmModule = mlir::translateModuleToLLVMIR(*mlirModule, *m_llvmContext);
+    }
     // Delete these now to release MLIRs resource and reduce peak memory usage.
     mlirModule = nullptr;
     m_mlirContext.reset();
@@ -552,6 +713,7 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
     passBuilder.crossRegisterProxies(lam, fam, cgam, mam);
 
     bool lto = enableLTO(commandLine);
+    bool thinLTO = lto && useThinLTO(args);
     llvm::ModulePassManager mpm;
     if (args.getLastArgValue(OPT_O, "0") == "0") {
       mpm =
@@ -566,20 +728,32 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
               .Case("4", llvm::OptimizationLevel::O3)
               .Case("s", llvm::OptimizationLevel::Os)
               .Case("z", llvm::OptimizationLevel::Oz);
-      if (lto)
+      if (thinLTO)
+        mpm = passBuilder.buildThinLTOPreLinkDefaultPipeline(level);
+      else if (lto)
         mpm = passBuilder.buildLTOPreLinkDefaultPipeline(level);
       else
         mpm = passBuilder.buildPerModuleDefaultPipeline(level);
     }
 
+    // Partitions are compiled in parallel. When linking with ThinLTO, the
+    // partitions are instead emitted as separate bitcode files and compiled by
+    // the linker. Thanks to the summaries, the linker is able to only
+    // recompile partitions that changed since the last link if a cache is
+    // used.
+    unsigned partitionCount =
+        action == Link && !shouldOutput(OPT_emit_llvm)
+            ? m_threadPool->getMaxConcurrency()
+            : 1;
+
     if (shouldOutput(OPT_emit_llvm) || lto) {
       // See
       // https://github.com/llvm/llvm-project/blob/ea22fdd120aeb1bbb9ea96670d70193dc02b2c5f/clang/lib/CodeGen/BackendUtil.cpp#L1467
-      // Doing full LTO for now
       bool emitLTOSummary =
-          lto &&
-          m_targetMachine->getTargetTriple().getVendor() != llvm::Triple::Apple;
-      if (emitLTOSummary) {
+          thinLTO ||
+          (lto && m_targetMachine->getTargetTriple().getVendor() !=
+                      llvm::Triple::Apple);
+      if (emitLTOSummary && !thinLTO) {
         if (!llvmModule->getModuleFlag("ThinLTO"))
           llvmModule->addModuleFlag(llvm::Module::Error, "ThinLTO",
                                     std::uint32_t(0));
@@ -592,11 +766,14 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
 
       if (action == pylir::CompilerInvocation::Assembly)
         mpm.addPass(llvm::PrintModulePass(*m_output));
-      else
+      else if (!thinLTO || partitionCount == 1)
         mpm.addPass(llvm::BitcodeWriterPass(*m_output, false, emitLTOSummary));
     }
 
-    mpm.run(*llvmModule, mam);
+    {
+      llvm::TimeTraceScope scope("LLVM Pipeline");
+      mpm.run(*llvmModule, mam);
+    }
     if (args.hasArg(OPT_Xprint_pipeline))
       mpm.printPipeline(llvm::errs(), [&](llvm::StringRef className) {
         auto passName = pic.getPassNameForClassName(className);
@@ -606,41 +783,32 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
     if (shouldOutput(OPT_emit_llvm))
       return finalizeOutputStream(mlir::success(), commandLine);
 
+    if (thinLTO && partitionCount > 1)
+      return codegenPartitions(std::move(llvmModule), partitionCount,
+                               commandLine, /*thinLTO=*/true);
+
     if (lto)
       break;
 
     if (mlir::failed(ensureOutputStream(args, action, commandLine)))
       return mlir::failure();
 
+    if (partitionCount > 1)
+      return codegenPartitions(std::move(llvmModule), partitionCount,
+                               commandLine);
+
+    llvm::CodeGenFileType fileType =
+        action == pylir::CompilerInvocation::Assembly
+            ? llvm::CodeGenFileType::AssemblyFile
+            : llvm::CodeGenFileType::ObjectFile;
     llvm::legacy::PassManager codeGenPasses;
     codeGenPasses.add(llvm::createTargetTransformInfoWrapperPass(
         m_targetMachine->getTargetIRAnalysis()));
-    if (m_targetMachine->addPassesToEmitFile(
-            codeGenPasses, *m_output, nullptr,
-            action == pylir::CompilerInvocation::Assembly
-                ? llvm::CodeGenFileType::AssemblyFile
-                : llvm::CodeGenFileType::ObjectFile)) {
-      std::string_view format = action == pylir::CompilerInvocation::Assembly
-                                    ? "Assembly"
-                                    : "Object file";
-      auto* arg = args.getLastArg(OPT_target_EQ);
-      if (!arg)
-        arg = args.getLastArg(OPT_c, OPT_S);
-
-      if (arg) {
-        commandLine
-            .createError(arg,
-                         pylir::Diag::TARGET_N_DOES_NOT_SUPPORT_COMPILING_TO_N,
-                         m_targetMachine->getTargetTriple().str(), format)
-            .addHighlight(arg);
-        return finalizeOutputStream(mlir::failure(), commandLine);
-      }
-      commandLine.createError(
-          pylir::Diag::TARGET_N_DOES_NOT_SUPPORT_COMPILING_TO_N,
-          m_targetMachine->getTargetTriple().str(), format);
-      return finalizeOutputStream(mlir::failure(), commandLine);
-    }
+    if (m_targetMachine->addPassesToEmitFile(codeGenPasses, *m_output, nullptr,
+                                             fileType))
+      return reportUnsupportedFileType(commandLine, fileType);
 
+    llvm::TimeTraceScope scope("Emit Object File");
     codeGenPasses.run(*llvmModule);
     break;
   }
@@ -648,6 +816,126 @@ mlir::LogicalResult pylir::CompilerInvocation::compilation(
   return mlir::success();
 }
 
+mlir::LogicalResult pylir::CompilerInvocation::codegenPartitions(
+    std::unique_ptr<llvm::Module>&& llvmModule, unsigned partitionCount,
+    cli::CommandLine& commandLine, bool thinLTO) {
+  pylir::prepareGCPartitioning(*llvmModule, partitionCount);
+
+  // Partitions are compiled within their own LLVM context to be able to
+  // compile them in parallel. They are transferred between contexts as
+  // bitcode.
+  std::vector<llvm::SmallString<0>> bitcodes;
+  {
+    llvm::TimeTraceScope scope("Split Module");
+    llvm::SplitModule(*llvmModule, partitionCount,
+                      [&](std::unique_ptr<llvm::Module> partition) {
+                        pylir::setGCPartition(*partition, bitcodes.size());
+                        llvm::raw_svector_ostream os(bitcodes.emplace_back());
+                        llvm::WriteBitcodeToFile(*partition, os);
+                      });
+  }
+  llvmModule.reset();
+
+  // The first partition is written to the regular output file.
+  std::vector<std::unique_ptr<llvm::raw_pwrite_stream>> outputs;
+  // Temporary object files are only kept if all partitions were compiled
+  // successfully.
+  auto removeObjectFiles = llvm::make_scope_exit([&] {
+    outputs.clear();
+    for (const std::string& objectFile : m_partitionObjectFiles)
+      llvm::sys::fs::remove(objectFile);
+    m_partitionObjectFiles.clear();
+  });
+  for (std::size_t i = 1; i < bitcodes.size(); i++) {
+    int fd;
+    llvm::SmallString<128> path;
+    if (llvm::sys::fs::createTemporaryFile("pylir-partition", "o", fd, path)) {
+      commandLine.createError(pylir::Diag::FAILED_TO_CREATE_TEMPORARY_FILE_N,
+                              path.str());
+      return finalizeOutputStream(mlir::failure(), commandLine);
+    }
+    m_partitionObjectFiles.emplace_back(path);
+    outputs.push_back(
+        std::make_unique<llvm::raw_fd_ostream>(fd, /*shouldClose=*/true));
+  }
+
+  std::atomic_bool unsupported = false;
+  llvm::ThreadPoolTaskGroup taskGroup(*m_threadPool);
+  for (auto&& [index, bitcode] : llvm::enumerate(bitcodes)) {
+    llvm::raw_pwrite_stream& os = index == 0 ? *m_output : *outputs[index - 1];
+    taskGroup.async([this, thinLTO, partitionIndex = index, &commandLine,
+                     &unsupported, &bitcode = bitcode, &os = os] {
+      TimeTraceTaskScope timeTraceTaskScope(m_timeTraceGranularity,
+                                            commandLine);
+      llvm::TimeTraceScope scope("CodeGen Partition", [&] {
+        return std::to_string(partitionIndex);
+      });
+      llvm::LLVMContext context;
+      std::unique_ptr<llvm::Module> partition =
+          llvm::cantFail(llvm::parseBitcodeFile(
+              llvm::MemoryBufferRef(bitcode, "partition"), context));
+
+      if (thinLTO) {
+        llvm::ProfileSummaryInfo profileSummaryInfo(*partition);
+        llvm::ModuleSummaryIndex index = llvm::buildModuleSummaryIndex(
+            *partition, nullptr, &profileSummaryInfo);
+        llvm::WriteBitcodeToFile(*partition, os,
+                                 /*ShouldPreserveUseListOrder=*/false, &index);
+        return;
+      }
+
+      std::unique_ptr<llvm::TargetMachine> targetMachine(
+          m_targetMachine->getTarget().createTargetMachine(
+              m_targetMachine->getTargetTriple().str(),
+              m_targetMachine->getTargetCPU(),
+              m_targetMachine->getTargetFeatureString(),
+              m_targetMachine->Options,
+              m_targetMachine->getRelocationModel(),
+              m_targetMachine->getCodeModel(),
+              m_targetMachine->getOptLevel()));
+
+      llvm::legacy::PassManager codeGenPasses;
+      codeGenPasses.add(llvm::createTargetTransformInfoWrapperPass(
+          targetMachine->getTargetIRAnalysis()));
+      if (targetMachine->addPassesToEmitFile(
+              codeGenPasses, os, nullptr, llvm::CodeGenFileType::ObjectFile)) {
+        unsupported = true;
+        return;
+      }
+      codeGenPasses.run(*partition);
+    });
+  }
+  taskGroup.wait();
+  if (unsupported)
+    return reportUnsupportedFileType(commandLine,
+                                     llvm::CodeGenFileType::ObjectFile);
+
+  removeObjectFiles.release();
+  return mlir::success();
+}
+
+mlir::LogicalResult pylir::CompilerInvocation::reportUnsupportedFileType(
+    cli::CommandLine& commandLine, llvm::CodeGenFileType fileType) {
+  const auto& args = commandLine.getArgs();
+  std::string_view format = fileType == llvm::CodeGenFileType::AssemblyFile
+                                ? "Assembly"
+                                : "Object file";
+  auto* arg = args.getLastArg(OPT_target_EQ);
+  if (!arg)
+    arg = args.getLastArg(OPT_c, OPT_S);
+
+  if (arg) {
+    commandLine
+        .createError(arg, pylir::Diag::TARGET_N_DOES_NOT_SUPPORT_COMPILING_TO_N,
+                     m_targetMachine->getTargetTriple().str(), format)
+        .addHighlight(arg);
+    return finalizeOutputStream(mlir::failure(), commandLine);
+  }
+  commandLine.createError(pylir::Diag::TARGET_N_DOES_NOT_SUPPORT_COMPILING_TO_N,
+                          m_targetMachine->getTargetTriple().str(), format);
+  return finalizeOutputStream(mlir::failure(), commandLine);
+}
+
 void pylir::CompilerInvocation::ensureMLIRContext() {
   if (m_mlirContext)
     return;
@@ -875,6 +1163,138 @@ pylir::CompilerInvocation::ensureLLVMInit(const llvm::opt::InputArgList& args,
       refs.size() - 1, refs.data(), "", &llvm::errs()));
 }
 
+namespace {
+
+/// Name of the attribute used to record the imports of a module within the
+/// module cache. It consists of an array with an '[name, start, end]' entry
+/// for every imported module, with 'start' and 'end' being the location of the
+/// import.
+constexpr llvm::StringLiteral MODULE_CACHE_IMPORTS = "pylir.imports";
+
+/// Returns a string identifying the compiler for the purpose of the module
+/// cache. Besides the version, the modification time of the executable is used
+/// to invalidate the cache on every rebuild of the compiler.
+std::string getCompilerIdentifier(const CommandLine& commandLine) {
+  std::string result = "Pylir " PYLIR_VERSION;
+  llvm::sys::fs::file_status status;
+  if (!llvm::sys::fs::status(commandLine.getExecutablePath(), status))
+    result += " " + std::to_string(status.getLastModificationTime()
+                                       .time_since_epoch()
+                                       .count());
+  return result;
+}
+
+/// Returns the path within 'cacheDir' at which the result of code generating
+/// 'buffer' with 'options' is cached.
+std::string getModuleCachePath(llvm::StringRef cacheDir,
+                               llvm::StringRef compilerIdentifier,
+                               const llvm::MemoryBuffer& buffer,
+                               const pylir::CodeGenOptions& options) {
+  llvm::BLAKE3 hasher;
+  auto addField = [&](llvm::StringRef field) {
+    std::uint64_t size = field.size();
+    hasher.update(llvm::ArrayRef(reinterpret_cast<const std::uint8_t*>(&size),
+                                 sizeof(size)));
+    hasher.update(field);
+  };
+  addField(compilerIdentifier);
+  // The filename is part of the key as it is contained in both the locations
+  // of the generated code and depfiles.
+  addField(buffer.getBufferIdentifier());
+  addField(options.qualifier);
+  addField(options.implicitBuiltinsImport ? "1" : "0");
+  addField(options.lazyModuleInit ? "1" : "0");
+  addField(buffer.getBuffer());
+
+  llvm::SmallString<128> path = cacheDir;
+  llvm::sys::path::append(
+      path, llvm::toHex(hasher.final(), /*LowerCase=*/true) + ".mlirbc");
+  return std::string(path);
+}
+
+/// Loads the module cached at 'path' and calls 'moduleLoadCallback' for every
+/// module it imports. Returns null if no valid module is cached at 'path'.
+mlir::OwningOpRef<mlir::ModuleOp> loadCachedModule(
+    llvm::StringRef path, mlir::MLIRContext* context,
+    pylir::Diag::DiagnosticsDocManager<>& docManager,
+    const decltype(pylir::CodeGenOptions::moduleLoadCallback)&
+        moduleLoadCallback) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+      llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return nullptr;
+
+  // The module does not verify until it is linked with all its imports.
+  auto body = std::make_unique<mlir::Block>();
+  if (mlir::failed(mlir::readBytecodeFile(
+          **buffer, body.get(),
+          mlir::ParserConfig(context, /*verifyAfterParse=*/false))))
+    return nullptr;
+
+  mlir::OwningOpRef<mlir::ModuleOp> module =
+      buildModuleIfNecessary(std::move(body), context);
+  auto imports = module->getOperation()->getAttrOfType<mlir::ArrayAttr>(
+      MODULE_CACHE_IMPORTS);
+  if (!imports)
+    return nullptr;
+  module->getOperation()->removeAttr(MODULE_CACHE_IMPORTS);
+
+  for (auto entry : imports.getAsRange<mlir::ArrayAttr>()) {
+    pylir::Diag::Location location;
+    if (entry.size() == 3)
+      location = pylir::Diag::Location(
+          llvm::cast<mlir::IntegerAttr>(entry[1]).getInt(),
+          llvm::cast<mlir::IntegerAttr>(entry[2]).getInt());
+    moduleLoadCallback(llvm::cast<mlir::StringAttr>(entry[0]).getValue(),
+                       &docManager, location);
+  }
+  return module;
+}
+
+/// Writes 'module' together with its 'imports' to 'path' in the module cache.
+/// The module is first written to a temporary file which is then renamed to
+/// 'path', preventing concurrent compilations from observing partially
+/// written files. Failing to write to the cache is not an error.
+void storeCachedModule(
+    llvm::StringRef path, mlir::ModuleOp module,
+    llvm::ArrayRef<std::pair<std::string, pylir::Diag::Location>> imports) {
+  mlir::Builder builder(module.getContext());
+  llvm::SmallVector<mlir::Attribute> entries;
+  for (const auto& [name, location] : imports) {
+    llvm::SmallVector<mlir::Attribute, 3> entry{builder.getStringAttr(name)};
+    if (location) {
+      entry.push_back(builder.getI64IntegerAttr(location->first));
+      entry.push_back(builder.getI64IntegerAttr(location->second));
+    }
+    entries.push_back(builder.getArrayAttr(entry));
+  }
+
+  int fd;
+  llvm::SmallString<128> tempPath;
+  if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%%%.tmp", fd, tempPath))
+    return;
+
+  module->setAttr(MODULE_CACHE_IMPORTS, builder.getArrayAttr(entries));
+  auto exit = llvm::make_scope_exit(
+      [&] { module->removeAttr(MODULE_CACHE_IMPORTS); });
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    if (mlir::failed(mlir::writeBytecodeToFile(
+            module, os, mlir::BytecodeWriterConfig("Pylir " PYLIR_VERSION))) ||
+        os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(tempPath);
+      return;
+    }
+  }
+
+  if (llvm::sys::fs::rename(tempPath, path))
+    llvm::sys::fs::remove(tempPath);
+}
+
+} // namespace
+
 mlir::FailureOr<mlir::OwningOpRef<mlir::ModuleOp>>
 pylir::CompilerInvocation::codegenPythonToMLIR(
     const llvm::opt::InputArgList& args, const cli::CommandLine& commandLine,
@@ -883,6 +1303,8 @@ pylir::CompilerInvocation::codegenPythonToMLIR(
   pylir::CodeGenOptions options{};
   options.implicitBuiltinsImport =
       args.hasFlag(OPT_Xbuiltins, OPT_Xno_builtins, true);
+  options.lazyModuleInit =
+      args.hasFlag(OPT_flazy_module_init, OPT_fno_lazy_module_init, false);
   std::vector<std::string> importPaths;
   {
     llvm::SmallString<100> docPath{m_documents.front().getFilename()};
@@ -918,6 +1340,13 @@ pylir::CompilerInvocation::codegenPythonToMLIR(
     importPaths.emplace_back(libDirPath);
   }
 
+  // Imported modules are cached on disk if a cache directory was specified.
+  // The main module is always compiled as it is expected to change most often.
+  std::string cacheDir = args.getLastArgValue(OPT_cache_dir_EQ).str();
+  if (!cacheDir.empty() && llvm::sys::fs::create_directories(cacheDir))
+    cacheDir.clear();
+  std::string compilerIdentifier = getCompilerIdentifier(commandLine);
+
   // Protects 'futures' and 'loaded'.
   std::mutex dataStructureMutex;
   std::vector<std::pair<std::shared_future<mlir::ModuleOp>, std::string>>
@@ -989,18 +1418,53 @@ pylir::CompilerInvocation::codegenPythonToMLIR(
         iter->second = (*buffer)->getBufferIdentifier();
 
         auto action = [=, &sourceDSMutex, &diagManager, &options,
+                       &commandLine,
                        buffer = std::shared_ptr(std::move(*buffer)),
                        absoluteModule =
                            absoluteModule.str()]() mutable -> mlir::ModuleOp {
+          TimeTraceTaskScope timeTraceTaskScope(m_timeTraceGranularity,
+                                                commandLine);
+          llvm::TimeTraceScope moduleScope("Module", absoluteModule);
+
           std::unique_lock sourceLock{sourceDSMutex};
           Diag::Document& document = addDocument(
               buffer->getBuffer(), buffer->getBufferIdentifier().str());
           sourceLock.unlock();
 
+          CodeGenOptions copyOption = options;
+          copyOption.qualifier = std::move(absoluteModule);
+
           Diag::DiagnosticsDocManager docManager =
               diagManager.createSubDiagnosticManager(document);
-          Parser parser(docManager);
-          std::optional<Syntax::FileInput> tree = parser.parseFileInput();
+
+          std::string cachePath;
+          std::vector<std::pair<std::string, Diag::Location>> imports;
+          if (!cacheDir.empty()) {
+            cachePath = getModuleCachePath(cacheDir, compilerIdentifier,
+                                           *buffer, copyOption);
+            if (mlir::OwningOpRef<mlir::ModuleOp> cached =
+                    loadCachedModule(cachePath, &*m_mlirContext, docManager,
+                                     options.moduleLoadCallback))
+              return cached.release();
+
+            // Record the imports of the module to replay them when loading the
+            // module from the cache.
+            copyOption.moduleLoadCallback =
+                [&](llvm::StringRef absoluteModule,
+                    Diag::DiagnosticsDocManager<>* diagnostics,
+                    Diag::LazyLocation location) {
+                  imports.emplace_back(absoluteModule, location());
+                  options.moduleLoadCallback(absoluteModule, diagnostics,
+                                             location);
+                };
+          }
+
+          std::optional<Syntax::FileInput> tree;
+          {
+            llvm::TimeTraceScope scope("Parse", buffer->getBufferIdentifier());
+            Parser parser(docManager);
+            tree = parser.parseFileInput();
+          }
           if (!tree || docManager.errorsOccurred())
             return nullptr;
 
@@ -1009,13 +1473,18 @@ pylir::CompilerInvocation::codegenPythonToMLIR(
               m_fileInputs.emplace_back(std::move(*tree));
           sourceLock.unlock();
 
-          CodeGenOptions copyOption = options;
-          copyOption.qualifier = std::move(absoluteModule);
-          mlir::OwningOpRef<mlir::ModuleOp> res = pylir::codegenModule(
-              &*m_mlirContext, fileInput, docManager, copyOption);
+          mlir::OwningOpRef<mlir::ModuleOp> res;
+          {
+            llvm::TimeTraceScope scope("CodeGen Module");
+            res = pylir::codegenModule(&*m_mlirContext, fileInput, docManager,
+                                       copyOption);
+          }
           if (docManager.errorsOccurred())
             return nullptr;
 
+          if (!cachePath.empty())
+            storeCachedModule(cachePath, *res, imports);
+
           return res.release();
         };
 
@@ -1033,6 +1502,10 @@ pylir::CompilerInvocation::codegenPythonToMLIR(
     futures.emplace_back(
         m_threadPool->async(taskGroup,
                             [&]() -> mlir::ModuleOp {
+                              TimeTraceTaskScope timeTraceTaskScope(
+                                  m_timeTraceGranularity, commandLine);
+                              llvm::TimeTraceScope scope("CodeGen Module",
+                                                         "__main__");
                               mlir::OwningOpRef<mlir::ModuleOp> mainModule =
                                   codegenModule(&*m_mlirContext,
                                                 m_fileInputs.front(),
@@ -11,6 +11,7 @@
 #include <mlir/Support/LogicalResult.h>
 
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
 #include <llvm/Option/Arg.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/ThreadPool.h>
@@ -24,6 +25,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 #include "CommandLine.hpp"
 #include "DiagnosticsVerifier.hpp"
@@ -44,6 +46,9 @@ class CompilerInvocation {
   std::optional<llvm::raw_fd_ostream> m_outFileStream;
   std::string m_compileStepOutputFilename;
   std::string m_actionOutputFilename;
+  std::vector<std::string> m_partitionObjectFiles;
+  /// Granularity of the time trace profiler in microseconds if enabled.
+  std::optional<unsigned> m_timeTraceGranularity;
   DiagnosticsVerifier* m_verifier;
 
   enum FileType { Python, MLIR, LLVM };
@@ -76,6 +81,33 @@ private:
                       const pylir::Toolchain& toolchain,
                       std::optional<llvm::Triple> triple = {});
 
+  /// Splits 'llvmModule' into 'partitionCount' partitions and compiles them in
+  /// parallel. The first partition is written to the output stream while all
+  /// others are written to temporary object files in
+  /// 'm_partitionObjectFiles'. If 'thinLTO' is true, the partitions are
+  /// written as ThinLTO bitcode files instead.
+  mlir::LogicalResult
+  codegenPartitions(std::unique_ptr<llvm::Module>&& llvmModule,
+                    unsigned partitionCount, cli::CommandLine& commandLine,
+                    bool thinLTO = false);
+
+  /// Emits an error that the target does not support emitting files of type
+  /// 'fileType' and finalizes the output stream.
+  mlir::LogicalResult reportUnsupportedFileType(cli::CommandLine& commandLine,
+                                                llvm::CodeGenFileType fileType);
+
+  /// Performs 'action' on 'inputFile' including writing the dependency file
+  /// and linking.
+  mlir::LogicalResult performAction(llvm::opt::Arg* inputFile,
+                                    cli::CommandLine& commandLine,
+                                    const pylir::Toolchain& toolchain,
+                                    CompilerInvocation::Action action,
+                                    Diag::DiagnosticsManager& diagManager);
+
+  /// Writes the trace of the time trace profiler to the file specified on the
+  /// command line or next to the output file.
+  mlir::LogicalResult writeTimeTrace(cli::CommandLine& commandLine);
+
   mlir::LogicalResult compilation(llvm::opt::Arg* inputFile,
                                   cli::CommandLine& commandLine,
                                   const pylir::Toolchain& toolchain,
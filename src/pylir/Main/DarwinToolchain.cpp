@@ -159,8 +159,9 @@ llvm::StringRef getMachOArchName(const llvm::Triple& triple) {
 }
 } // namespace
 
-bool pylir::DarwinToolchain::link(pylir::cli::CommandLine& commandLine,
-                                  llvm::StringRef objectFile) const {
+bool pylir::DarwinToolchain::link(
+    pylir::cli::CommandLine& commandLine,
+    llvm::ArrayRef<std::string> objectFiles) const {
   const auto& args = commandLine.getArgs();
 
   auto linkerInvocation = LinkerInvocationBuilder(LinkerStyle::Mac);
@@ -187,6 +188,7 @@ bool pylir::DarwinToolchain::link(pylir::cli::CommandLine& commandLine,
       .addArg(sdkVersion.getAsString())
       .addArg("-pie", isPIE(commandLine))
       .addLLVMOptions(getLLVMOptions(args))
+      .addLTOCacheDir(getLTOCacheDir(args))
       .addArg("-syslibroot", !m_sdkRoot.empty())
       .addArg(m_sdkRoot, !m_sdkRoot.empty());
 
@@ -214,7 +216,7 @@ bool pylir::DarwinToolchain::link(pylir::cli::CommandLine& commandLine,
     }
   }
 
-  linkerInvocation.addArg(objectFile)
+  linkerInvocation.addArgs(objectFiles)
       .addLibrary("PylirRuntime")
       .addLibrary("PylirMarkAndSweep")
       .addLibrary("PylirRuntimeMain")
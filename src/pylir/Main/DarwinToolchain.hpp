@@ -27,6 +27,6 @@ public:
   DarwinToolchain(llvm::Triple triple, cli::CommandLine& commandLine);
 
   bool link(cli::CommandLine& commandLine,
-            llvm::StringRef objectFile) const override;
+            llvm::ArrayRef<std::string> objectFiles) const override;
 };
 } // namespace pylir
@@ -62,6 +62,12 @@ constexpr auto UNSUPPORTED_TARGET_N = FMT_STRING("unsupported target '{}'");
 constexpr auto INVALID_OPTIMIZATION_LEVEL_N =
     FMT_STRING("invalid optimization level '{}'");
 
+constexpr auto INVALID_TIME_TRACE_GRANULARITY_N =
+    FMT_STRING("invalid time trace granularity '{}'");
+
+constexpr auto FAILED_TO_WRITE_TIME_TRACE_N =
+    FMT_STRING("failed to write time trace '{}'");
+
 constexpr auto TARGET_N_DOES_NOT_SUPPORT_COMPILING_TO_N =
     FMT_STRING("target '{}' does not support compiling to {}");
 
@@ -71,23 +71,24 @@ constexpr static auto TEXT_WITHIN_PATTERN =
 
 void pylir::DiagnosticsVerifier::addDocument(
     const pylir::Diag::Document& document) {
-  for (const auto& iter : ctre::multiline_range<PATTERN>(document.getText())) {
+  std::string_view source = document.getText();
+  for (const auto& iter : ctre::multiline_range<PATTERN>(source)) {
     Diag::Severity severity;
-    if (iter.get<KIND>() == U"error")
+    if (iter.get<KIND>() == "error")
       severity = Diag::Severity::Error;
-    else if (iter.get<KIND>() == U"note")
+    else if (iter.get<KIND>() == "note")
       severity = Diag::Severity::Note;
-    else if (iter.get<KIND>() == U"warning")
+    else if (iter.get<KIND>() == "warning")
       severity = Diag::Severity::Warning;
 
-    std::size_t line = document.getLineNumber(iter.data() - document.begin());
+    std::size_t line = document.getLineNumber(iter.data() - source.data());
     if (iter.get<REL>()) {
       auto view = iter.get<REL>().view();
-      bool add = view.front() == U'+';
+      bool add = view.front() == '+';
       view = view.substr(1);
       std::size_t offset = 0;
-      for (char32_t c : view)
-        offset = offset * 10 + (c - U'0');
+      for (char c : view)
+        offset = offset * 10 + (c - '0');
 
       if (add)
         line += offset;
@@ -102,35 +103,32 @@ void pylir::DiagnosticsVerifier::addDocument(
     for (const auto& iter2 :
          ctre::multiline_range<TEXT_WITHIN_PATTERN>(iter.get<TEXT>())) {
       auto textWithin = iter2.get<TEXT>();
-      std::size_t start = textWithin.data() - document.begin();
+      std::size_t start = textWithin.data() - source.data();
       std::size_t end = start + textWithin.size();
       if (!iter.get<RE>()) {
         m_fileLineToExpectedMessages[{&document, line}].push_back(
-            {start, end, severity, nullptr,
-             Text::toUTF8String(textWithin.view())});
+            {start, end, severity, nullptr, std::string(textWithin.view())});
         continue;
       }
       std::string regexRes;
       llvm::raw_string_ostream regexOS(regexRes);
-      std::u32string_view strToProcess = textWithin.view();
+      std::string_view strToProcess = textWithin.view();
       while (!strToProcess.empty()) {
         // Find the next regex block.
-        size_t regexIt = strToProcess.find(U"{{");
+        size_t regexIt = strToProcess.find("{{");
         if (regexIt == std::string::npos) {
-          regexOS << llvm::Regex::escape(Text::toUTF8String(strToProcess));
+          regexOS << llvm::Regex::escape(strToProcess);
           break;
         }
-        regexOS << llvm::Regex::escape(
-            Text::toUTF8String(strToProcess.substr(0, regexIt)));
+        regexOS << llvm::Regex::escape(strToProcess.substr(0, regexIt));
         strToProcess = strToProcess.substr(regexIt + 2);
 
         // Find the end of the regex block.
-        size_t regexEndIt = strToProcess.find(U"}}");
+        size_t regexEndIt = strToProcess.find("}}");
         if (regexEndIt == std::string::npos) {
           m_errorsOccurred = true;
           auto openBracketPos =
-              static_cast<std::size_t>(strToProcess.data() - document.begin()) -
-              2;
+              static_cast<std::size_t>(strToProcess.data() - source.data()) - 2;
           llvm::errs() << Diag::DiagnosticsBuilder(
                               document, Diag::Severity::Error, openBracketPos,
                               "found start of regex with no end '}}}}'")
@@ -138,14 +136,13 @@ void pylir::DiagnosticsVerifier::addDocument(
                               .getDiagnostic();
           continue;
         }
-        std::string regexStr =
-            Text::toUTF8String(strToProcess.substr(0, regexEndIt));
+        std::string regexStr(strToProcess.substr(0, regexEndIt));
 
         // Validate that the regex is actually valid.
         std::string regexError;
         if (!llvm::Regex(regexStr).isValid(regexError)) {
           m_errorsOccurred = true;
-          std::size_t regexStart = strToProcess.data() - document.begin();
+          std::size_t regexStart = strToProcess.data() - source.data();
           std::size_t regexEnd = regexStart + regexEndIt;
           llvm::errs() << Diag::DiagnosticsBuilder(
                               document, Diag::Severity::Error, regexStart,
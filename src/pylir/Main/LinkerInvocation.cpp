@@ -60,6 +60,28 @@ pylir::LinkerInvocationBuilder& pylir::LinkerInvocationBuilder::addLLVMOptions(
   return *this;
 }
 
+pylir::LinkerInvocationBuilder&
+pylir::LinkerInvocationBuilder::addLTOCacheDir(llvm::StringRef directory) {
+  if (directory.empty())
+    return *this;
+
+  switch (m_linkerStyle) {
+  case LinkerStyle::MSVC:
+    m_args.push_back(("/lldltocache:" + directory).str());
+    break;
+  case LinkerStyle::Mac:
+    m_args.emplace_back("-cache_path_lto");
+    m_args.emplace_back(directory);
+    break;
+  case LinkerStyle::MinGW:
+  case LinkerStyle::ELF:
+    m_args.push_back(("--thinlto-cache-dir=" + directory).str());
+    break;
+  default: PYLIR_UNREACHABLE;
+  }
+  return *this;
+}
+
 pylir::LinkerInvocationBuilder&
 pylir::LinkerInvocationBuilder::addLibrarySearchDir(llvm::Twine directory) {
   switch (m_linkerStyle) {
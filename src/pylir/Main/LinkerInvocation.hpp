@@ -89,6 +89,10 @@ public:
   /// Passes the given internal LLVM options to the linker.
   LinkerInvocationBuilder& addLLVMOptions(llvm::ArrayRef<std::string> options);
 
+  /// Tells the linker to cache the results of LTO in 'directory'. Does nothing
+  /// if 'directory' is empty.
+  LinkerInvocationBuilder& addLTOCacheDir(llvm::StringRef directory);
+
   /// Adds the emulation option to the linker, telling it about the target
   /// architecture. Only allowed for ELF and MinGW style!
   LinkerInvocationBuilder& addEmulation(const llvm::Triple& triple);
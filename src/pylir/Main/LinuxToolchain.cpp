@@ -191,8 +191,9 @@ pylir::LinuxToolchain::LinuxToolchain(llvm::Triple triple,
     findClangInstallation(commandLine);
 }
 
-bool pylir::LinuxToolchain::link(cli::CommandLine& commandLine,
-                                 llvm::StringRef objectFile) const {
+bool pylir::LinuxToolchain::link(
+    cli::CommandLine& commandLine,
+    llvm::ArrayRef<std::string> objectFiles) const {
   const auto& args = commandLine.getArgs();
 
   auto linkerInvocation = LinkerInvocationBuilder(LinkerStyle::ELF);
@@ -219,7 +220,8 @@ bool pylir::LinuxToolchain::link(cli::CommandLine& commandLine,
       .addArg("--eh-frame-hdr")
       .addEmulation(m_triple)
       .addArgs("-dynamic-linker", getDynamicLinker(m_triple, commandLine))
-      .addLLVMOptions(getLLVMOptions(args));
+      .addLLVMOptions(getLLVMOptions(args))
+      .addLTOCacheDir(getLTOCacheDir(args));
 
   if (auto* output = args.getLastArg(cli::OPT_o))
     linkerInvocation.addOutputFile(output->getValue());
@@ -289,7 +291,7 @@ bool pylir::LinuxToolchain::link(cli::CommandLine& commandLine,
     }
   }
 
-  linkerInvocation.addArg(objectFile)
+  linkerInvocation.addArgs(objectFiles)
       .addArg("--start-group")
       .addLibrary("PylirRuntime")
       .addLibrary("PylirMarkAndSweep")
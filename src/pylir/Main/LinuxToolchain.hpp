@@ -17,7 +17,8 @@ class LinuxToolchain : public Toolchain {
 public:
   explicit LinuxToolchain(llvm::Triple triple, cli::CommandLine& commandLine);
 
-  [[nodiscard]] bool link(cli::CommandLine& commandLine,
-                          llvm::StringRef objectFile) const override;
+  [[nodiscard]] bool
+  link(cli::CommandLine& commandLine,
+       llvm::ArrayRef<std::string> objectFiles) const override;
 };
 } // namespace pylir
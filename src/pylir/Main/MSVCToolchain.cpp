@@ -6,13 +6,15 @@
 
 #include <llvm/Support/Path.h>
 
-bool pylir::MSVCToolchain::link(cli::CommandLine& commandLine,
-                                llvm::StringRef objectFile) const {
+bool pylir::MSVCToolchain::link(
+    cli::CommandLine& commandLine,
+    llvm::ArrayRef<std::string> objectFiles) const {
   const auto& args = commandLine.getArgs();
 
   auto linkerInvocation = LinkerInvocationBuilder(LinkerStyle::MSVC);
 
   linkerInvocation.addLLVMOptions(getLLVMOptions(args))
+      .addLTOCacheDir(getLTOCacheDir(args))
       .addLibrarySearchDirs(args.getAllArgValues(cli::OPT_L))
       .addArg("-nologo")
       .addArg("/debug", args.getLastArgValue(cli::OPT_g, "0") != "0");
@@ -39,7 +41,7 @@ bool pylir::MSVCToolchain::link(cli::CommandLine& commandLine,
   }
 
   linkerInvocation.addArgs(args.getAllArgValues(cli::OPT_Wl))
-      .addArg(objectFile);
+      .addArgs(objectFiles);
 
   linkerInvocation.addLibrarySearchDirs(m_builtinLibrarySearchDirs)
       .addLibrary("PylirRuntime")
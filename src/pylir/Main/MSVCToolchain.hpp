@@ -17,7 +17,8 @@ protected:
 public:
   using Toolchain::Toolchain;
 
-  [[nodiscard]] bool link(cli::CommandLine& commandLine,
-                          llvm::StringRef objectFile) const override;
+  [[nodiscard]] bool
+  link(cli::CommandLine& commandLine,
+       llvm::ArrayRef<std::string> objectFiles) const override;
 };
 } // namespace pylir
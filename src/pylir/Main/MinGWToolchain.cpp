@@ -64,8 +64,9 @@ pylir::MinGWToolchain::MinGWToolchain(llvm::Triple triple,
   addIfExists(m_clangInstallation.getRootDir(), "lib", m_triple.str());
 }
 
-bool pylir::MinGWToolchain::link(cli::CommandLine& commandLine,
-                                 llvm::StringRef objectFile) const {
+bool pylir::MinGWToolchain::link(
+    cli::CommandLine& commandLine,
+    llvm::ArrayRef<std::string> objectFiles) const {
   const auto& args = commandLine.getArgs();
 
   auto linkerInvocation =
@@ -74,6 +75,7 @@ bool pylir::MinGWToolchain::link(cli::CommandLine& commandLine,
                   !m_clangInstallation.getRootDir().empty())
           .addEmulation(m_triple)
           .addLLVMOptions(getLLVMOptions(args))
+          .addLTOCacheDir(getLTOCacheDir(args))
           .addArg("-Bstatic");
 
   if (auto* output = args.getLastArg(cli::OPT_o)) {
@@ -88,7 +90,7 @@ bool pylir::MinGWToolchain::link(cli::CommandLine& commandLine,
       .addArg(findOnBuiltinPaths("crtbegin.o"))
       .addLibrarySearchDirs(args.getAllArgValues(cli::OPT_L))
       .addLibrarySearchDirs(m_builtinLibrarySearchDirs)
-      .addArg(objectFile);
+      .addArgs(objectFiles);
 
   for (auto* arg : args) {
     if (arg->getOption().matches(cli::OPT_l)) {
@@ -20,7 +20,8 @@ protected:
 public:
   MinGWToolchain(llvm::Triple triple, cli::CommandLine& commandLine);
 
-  [[nodiscard]] bool link(cli::CommandLine& commandLine,
-                          llvm::StringRef objectFile) const override;
+  [[nodiscard]] bool
+  link(cli::CommandLine& commandLine,
+       llvm::ArrayRef<std::string> objectFiles) const override;
 };
 } // namespace pylir
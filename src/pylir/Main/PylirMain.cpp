@@ -140,7 +140,7 @@ int pylir::main(int argc, char** argv) {
       !args.hasArg(OPT_emit_pylir, OPT_emit_llvm) &&
       (action == pylir::CompilerInvocation::Assembly ||
        action == pylir::CompilerInvocation::ObjectFile) &&
-      !args.hasArg(OPT_flto, OPT_fno_lto)) {
+      !args.hasArg(OPT_flto, OPT_flto_EQ, OPT_fno_lto)) {
     commandLine
         .createWarning(
             opt, pylir::Diag::O4_MAY_ENABLE_LTO_COMPILER_MIGHT_OUTPUT_LLVM_IR,
@@ -149,8 +149,8 @@ int pylir::main(int argc, char** argv) {
         .addHighlight(opt);
   }
 
-  if (auto* opt = args.getLastArg(OPT_flto, OPT_fno_lto);
-      opt && opt->getOption().matches(OPT_flto) &&
+  if (auto* opt = args.getLastArg(OPT_flto, OPT_flto_EQ, OPT_fno_lto);
+      opt && !opt->getOption().matches(OPT_fno_lto) &&
       !args.hasArg(OPT_emit_pylir, OPT_emit_llvm) &&
       (action == pylir::CompilerInvocation::Assembly ||
        action == pylir::CompilerInvocation::ObjectFile)) {
@@ -194,6 +194,17 @@ pylir::Toolchain::getLLVMOptions(const llvm::opt::InputArgList& args) const {
   return result;
 }
 
+std::string
+pylir::Toolchain::getLTOCacheDir(const llvm::opt::InputArgList& args) const {
+  llvm::StringRef cacheDir = args.getLastArgValue(pylir::cli::OPT_cache_dir_EQ);
+  if (cacheDir.empty())
+    return "";
+
+  llvm::SmallString<128> path = cacheDir;
+  llvm::sys::path::append(path, "lto");
+  return std::string(path);
+}
+
 std::string pylir::Toolchain::findOnBuiltinPaths(llvm::StringRef file) const {
   auto sep = llvm::sys::path::get_separator();
   for (const auto& iter : m_builtinLibrarySearchDirs)
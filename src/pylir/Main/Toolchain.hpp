@@ -58,8 +58,14 @@ public:
   [[nodiscard]] std::vector<std::string>
   getLLVMOptions(const llvm::opt::InputArgList& args) const;
 
-  [[nodiscard]] virtual bool link(cli::CommandLine& commandLine,
-                                  llvm::StringRef objectFile) const = 0;
+  /// Returns the directory the linker should use to cache the results of LTO
+  /// or an empty string if no cache should be used.
+  [[nodiscard]] std::string
+  getLTOCacheDir(const llvm::opt::InputArgList& args) const;
+
+  [[nodiscard]] virtual bool
+  link(cli::CommandLine& commandLine,
+       llvm::ArrayRef<std::string> objectFiles) const = 0;
 
   [[nodiscard]] bool isPIE(const pylir::cli::CommandLine& commandLine) const;
 
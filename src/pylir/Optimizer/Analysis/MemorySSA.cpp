@@ -165,7 +165,16 @@ void pylir::MemorySSA::fillRegion(
     builder.setInsertionPointToStart(memBlock);
 
     for (auto& op : block) {
+      mlir::Operation* lastAccess =
+          memBlock->empty() ? nullptr : &memBlock->back();
       maybeAddAccess(builder, &op, ssaBuilder, lastDefs);
+      for (mlir::Operation& access : llvm::make_range(
+               lastAccess ? std::next(lastAccess->getIterator())
+                          : memBlock->begin(),
+               memBlock->end()))
+        if (mlir::isa<MemSSA::MemoryUseOp, MemSSA::MemoryDefOp>(access))
+          m_accesses[&op].push_back(&access);
+
       auto regionBranchOp = mlir::dyn_cast<mlir::RegionBranchOpInterface>(&op);
       if (!regionBranchOp)
         continue;
@@ -205,8 +214,10 @@ void pylir::MemorySSA::fillRegion(
           };
 
       auto entryBlocks = getRegionSuccBlocks(successors);
-      builder.create<pylir::MemSSA::MemoryBranchOp>(
+      auto entryBranch = builder.create<pylir::MemSSA::MemoryBranchOp>(
           llvm::SmallVector<mlir::ValueRange>(entryBlocks.size()), entryBlocks);
+      m_regionEntries[&op] = entryBranch;
+      m_branchInstructions[entryBranch] = &op;
 
       llvm::SmallVector<mlir::Region*> workList;
 
@@ -239,10 +250,12 @@ void pylir::MemorySSA::fillRegion(
       memBlock = continueRegion;
     }
 
+    m_blockExitMapping[&block] = memBlock;
     if (block.getTerminator()->hasTrait<mlir::OpTrait::ReturnLike>()) {
-      builder.create<pylir::MemSSA::MemoryBranchOp>(
+      auto exitBranch = builder.create<pylir::MemSSA::MemoryBranchOp>(
           llvm::SmallVector<mlir::ValueRange>(regionSuccessors.size()),
           regionSuccessors);
+      m_branchInstructions[exitBranch] = block.getTerminator();
       continue;
     }
 
@@ -261,9 +274,10 @@ void pylir::MemorySSA::fillRegion(
       }
       memSuccessors.push_back(lookup->second);
     }
-    builder.create<pylir::MemSSA::MemoryBranchOp>(
+    auto exitBranch = builder.create<pylir::MemSSA::MemoryBranchOp>(
         llvm::SmallVector<mlir::ValueRange>(memSuccessors.size()),
         memSuccessors);
+    m_branchInstructions[exitBranch] = block.getTerminator();
     llvm::for_each(sealAfter,
                    [&](mlir::Block* lookup) { ssaBuilder.sealBlock(lookup); });
   }
@@ -359,6 +373,111 @@ pylir::MemorySSA::MemorySSA(mlir::Operation* operation,
   optimizeUses(analysisManager);
 }
 
+llvm::ArrayRef<mlir::Operation*>
+pylir::MemorySSA::getMemoryAccesses(mlir::Operation* instruction) const {
+  auto iter = m_accesses.find(instruction);
+  if (iter == m_accesses.end())
+    return {};
+  return iter->second;
+}
+
+mlir::OpBuilder::InsertPoint
+pylir::MemorySSA::getInsertionPoint(mlir::Operation* instruction) {
+  // The accesses of the next instruction having any mark the position.
+  // Operations with regions additionally have a branch into their regions.
+  for (mlir::Operation* iter = instruction->getNextNode(); iter;
+       iter = iter->getNextNode()) {
+    if (llvm::ArrayRef<mlir::Operation*> accesses = getMemoryAccesses(iter);
+        !accesses.empty())
+      return {accesses.front()->getBlock(), accesses.front()->getIterator()};
+
+    if (mlir::Operation* entryBranch = m_regionEntries.lookup(iter))
+      return {entryBranch->getBlock(), entryBranch->getIterator()};
+  }
+
+  mlir::Block* exitBlock = m_blockExitMapping.lookup(instruction->getBlock());
+  PYLIR_ASSERT(exitBlock);
+  return {exitBlock, exitBlock->getTerminator()->getIterator()};
+}
+
+mlir::Operation* pylir::MemorySSA::getInstruction(mlir::Operation* access) {
+  return llvm::TypeSwitch<mlir::Operation*, mlir::Operation*>(access)
+      .Case<MemSSA::MemoryUseOp, MemSSA::MemoryDefOp>(
+          [](auto op) { return op.getInstruction(); })
+      .Default([&](mlir::Operation* op) {
+        return m_branchInstructions.lookup(op);
+      });
+}
+
+pylir::MemSSA::MemoryUseOp pylir::MemorySSA::createMemoryUse(
+    mlir::Operation* instruction, mlir::Value definition,
+    llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>>
+        reads) {
+  mlir::OpBuilder builder(instruction->getContext());
+  builder.restoreInsertionPoint(getInsertionPoint(instruction));
+  auto use = builder.create<MemSSA::MemoryUseOp>(
+      builder.getUnknownLoc(), definition, instruction, reads);
+  m_accesses[instruction].push_back(use);
+  return use;
+}
+
+pylir::MemSSA::MemoryDefOp pylir::MemorySSA::createMemoryDef(
+    mlir::Operation* instruction, mlir::Value clobbered,
+    llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>>
+        writes,
+    llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>> reads,
+    mlir::DominanceInfo& dominanceInfo) {
+  mlir::OpBuilder builder(instruction->getContext());
+  builder.restoreInsertionPoint(getInsertionPoint(instruction));
+  auto def = builder.create<MemSSA::MemoryDefOp>(
+      builder.getUnknownLoc(), clobbered, instruction, writes, reads);
+  m_accesses[instruction].push_back(def);
+
+  for (mlir::OpOperand& use : llvm::make_early_inc_range(clobbered.getUses())) {
+    mlir::Operation* user = use.getOwner();
+    if (user == def)
+      continue;
+
+    mlir::Operation* userInstruction = getInstruction(user);
+    if (!userInstruction)
+      continue;
+
+    // Accesses of the same instruction, including the branch of a terminator,
+    // are only dominated if they are located after the new def.
+    bool dominated = userInstruction == instruction
+                         ? def->getBlock() == user->getBlock() &&
+                               def->isBeforeInBlock(user)
+                         : dominanceInfo.properlyDominates(instruction,
+                                                           userInstruction);
+    if (dominated)
+      use.set(def);
+  }
+  return def;
+}
+
+void pylir::MemorySSA::removeMemoryAccesses(mlir::Operation* instruction) {
+  auto iter = m_accesses.find(instruction);
+  if (iter == m_accesses.end())
+    return;
+
+  for (mlir::Operation* access : llvm::reverse(iter->second)) {
+    if (auto def = mlir::dyn_cast<MemSSA::MemoryDefOp>(access))
+      def.replaceAllUsesWith(def.getClobbered());
+    access->erase();
+  }
+  m_accesses.erase(iter);
+}
+
+void pylir::MemorySSA::moveMemoryAccesses(mlir::Operation* instruction) {
+  auto iter = m_accesses.find(instruction);
+  if (iter == m_accesses.end())
+    return;
+
+  mlir::OpBuilder::InsertPoint insertionPoint = getInsertionPoint(instruction);
+  for (mlir::Operation* access : iter->second)
+    access->moveBefore(insertionPoint.getBlock(), insertionPoint.getPoint());
+}
+
 void pylir::MemorySSA::dump() const {
   m_region.get()->dump();
 }
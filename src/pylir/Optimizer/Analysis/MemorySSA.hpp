@@ -5,6 +5,7 @@
 #pragma once
 
 #include <mlir/Analysis/AliasAnalysis.h>
+#include <mlir/IR/Builders.h>
 #include <mlir/IR/Operation.h>
 #include <mlir/IR/OwningOpRef.h>
 #include <mlir/Pass/AnalysisManager.h>
@@ -19,6 +20,7 @@
 #include "MemorySSAIR.hpp"
 
 namespace mlir {
+class DominanceInfo;
 class ImplicitLocOpBuilder;
 } // namespace mlir
 
@@ -27,9 +29,30 @@ namespace pylir {
 class MemorySSA {
   mlir::OwningOpRef<MemSSA::MemoryModuleOp> m_region;
   llvm::DenseMap<mlir::Block*, mlir::Block*> m_blockMapping;
+  /// Maps blocks to the memory block containing the branch corresponding to
+  /// their terminator. This differs from 'm_blockMapping' if the block contains
+  /// operations with regions.
+  llvm::DenseMap<mlir::Block*, mlir::Block*> m_blockExitMapping;
+  /// 'MemoryUseOp's and 'MemoryDefOp's of every instruction in the order they
+  /// appear in the memory region.
+  llvm::DenseMap<mlir::Operation*, llvm::SmallVector<mlir::Operation*, 1>>
+      m_accesses;
+  /// Maps operations with regions to the 'MemoryBranchOp' branching into their
+  /// regions.
+  llvm::DenseMap<mlir::Operation*, mlir::Operation*> m_regionEntries;
+  /// Maps 'MemoryBranchOp's to the instruction they were created for. This is
+  /// either a terminator or an operation with regions.
+  llvm::DenseMap<mlir::Operation*, mlir::Operation*> m_branchInstructions;
 
   void createIR(mlir::Operation* operation);
 
+  /// Returns the position within the memory region corresponding to the
+  /// position directly after 'instruction'.
+  mlir::OpBuilder::InsertPoint getInsertionPoint(mlir::Operation* instruction);
+
+  /// Returns the instruction 'access' was created for.
+  mlir::Operation* getInstruction(mlir::Operation* access);
+
   void optimizeUses(mlir::AnalysisManager& analysisManager);
 
   void fillRegion(mlir::Region& region, mlir::ImplicitLocOpBuilder& builder,
@@ -46,6 +69,48 @@ public:
     return m_region->getBody();
   }
 
+  /// Returns all 'MemoryUseOp's and 'MemoryDefOp's of 'instruction'.
+  llvm::ArrayRef<mlir::Operation*>
+  getMemoryAccesses(mlir::Operation* instruction) const;
+
+  // The methods below allow passes to keep the analysis up to date while
+  // transforming the IR, allowing them to mark it as preserved.
+
+  /// Creates a new 'MemoryUseOp' for 'instruction' reading 'reads' from
+  /// 'definition'. 'instruction' must already be at its final position within
+  /// the IR and 'definition' has to dominate it.
+  MemSSA::MemoryUseOp createMemoryUse(
+      mlir::Operation* instruction, mlir::Value definition,
+      llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>>
+          reads);
+
+  /// Creates a new 'MemoryDefOp' for 'instruction' clobbering 'clobbered'.
+  /// 'instruction' must already be at its final position within the IR. All
+  /// accesses using 'clobbered' that are dominated by 'instruction' within the
+  /// same region are changed to use the new def instead. It is the callers
+  /// responsibility that no new block arguments are required in the memory
+  /// region, which is the case if e.g. an existing def at the same position is
+  /// replaced.
+  MemSSA::MemoryDefOp createMemoryDef(
+      mlir::Operation* instruction, mlir::Value clobbered,
+      llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>>
+          writes,
+      llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>>
+          reads,
+      mlir::DominanceInfo& dominanceInfo);
+
+  /// Removes all memory accesses of 'instruction'. Any users of a
+  /// 'MemoryDefOp' of 'instruction' use its clobbered definition instead. Has
+  /// to be called prior to erasing 'instruction'.
+  void removeMemoryAccesses(mlir::Operation* instruction);
+
+  /// Moves all memory accesses of 'instruction' to the position corresponding
+  /// to its current position in the IR. Has to be called after moving
+  /// 'instruction'. Definitions and users of the accesses remain unchanged,
+  /// meaning the caller has to make sure that the definitions still dominate
+  /// and the users are still dominated by 'instruction'.
+  void moveMemoryAccesses(mlir::Operation* instruction);
+
   void dump() const;
 
   void print(llvm::raw_ostream& out) const;
@@ -7,6 +7,7 @@
 #include <mlir/Pass/Pass.h>
 #include <mlir/Transforms/DialectConversion.h>
 
+#include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/ScopeExit.h>
 
 #include <pylir/Optimizer/Conversion/Passes.hpp>
@@ -404,17 +405,69 @@ struct InitOpConversionPattern : OpRewritePattern<InitOp> {
     // arguments.
     rewriter.inlineRegionBefore(op.getBody(), funcOp.getBody(),
                                 funcOp.getBody().end());
+    if (!op.isMainModule())
+      guardInitialization(rewriter, funcOp);
+
     rewriter.eraseOp(op);
     return success();
   }
+
+private:
+  /// Makes sure the body of the init function 'funcOp' is only ever executed
+  /// once, regardless of how often the function is called. This is done by
+  /// introducing a new global that is set to 1 the first time the function is
+  /// called. The global is set prior to executing the body to make any
+  /// recursive initialization a no-op.
+  static void guardInitialization(PatternRewriter& rewriter,
+                                  Py::FuncOp funcOp) {
+    Location loc = funcOp.getLoc();
+    auto global = rewriter.create<Py::GlobalOp>(
+        loc, (funcOp.getName() + "$initialized").str(),
+        rewriter.getStringAttr("private"), rewriter.getIndexType(),
+        rewriter.getIndexAttr(0));
+
+    Block* body = &funcOp.getBody().front();
+    OpBuilder::InsertionGuard guard{rewriter};
+    Block* markBlock = rewriter.createBlock(body);
+    Value one = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    rewriter.create<Py::StoreOp>(loc, one, FlatSymbolRefAttr::get(global));
+    rewriter.create<cf::BranchOp>(loc, body);
+
+    Block* returnBlock = rewriter.createBlock(body);
+    rewriter.create<Py::ReturnOp>(loc);
+
+    rewriter.createBlock(markBlock);
+    Value initialized = rewriter.create<Py::LoadOp>(loc, global);
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value isInitialized = rewriter.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::ne, initialized, zero);
+    rewriter.create<cf::CondBranchOp>(loc, isInitialized, returnBlock,
+                                      markBlock);
+  }
 };
 
-DEFINE_EX_PATTERN(InitModuleOp, op, ExceptionRewriter& rewriter) {
-  rewriter.create<Py::CallOp>(op.getLoc(), ValueRange(),
-                              (op.getModule() + ".__init__").str());
-  rewriter.eraseOp(op);
-  return success();
-}
+struct InitModuleOpConversionPattern final
+    : OpExRewritePattern<InitModuleOpInterface> {
+  InitModuleOpConversionPattern(MLIRContext* context,
+                                const llvm::DenseSet<StringAttr>& lazyModules)
+      : Base(context), m_lazyModules(lazyModules) {}
+
+  LogicalResult matchAndRewrite(InitModuleOpInterface op,
+                                ExceptionRewriter& rewriter) const override {
+    // Lazily initialized modules are initialized by the functions accessing
+    // their globals.
+    if (!op.getDeferrable() ||
+        !m_lazyModules.contains(op.getModuleAttr().getAttr()))
+      rewriter.create<Py::CallOp>(op.getLoc(), ValueRange(),
+                                  (op.getModule() + ".__init__").str());
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  /// Names of all 'pyHIR.init' operations marked 'lazy'.
+  const llvm::DenseSet<StringAttr>& m_lazyModules;
+};
 
 /// Lowering pattern for any Op that is `ReturnLike` to `py.return`.
 /// Returns ALL its operands.
@@ -863,15 +916,23 @@ void ConvertPylirHIRToPylirPy::runOnOperation() {
 
   target.addIllegalDialect<HIR::PylirHIRDialect>();
 
+  // Collected prior to the conversion, as 'pyHIR.init' operations may be
+  // converted before any of their uses.
+  llvm::DenseSet<StringAttr> lazyModules;
+  for (auto initOp : getOperation().getOps<InitOp>())
+    if (initOp.getLazy())
+      lazyModules.insert(initOp.getSymNameAttr());
+
   RewritePatternSet patterns(&getContext());
   patterns.add<InitOpConversionPattern, ReturnOpLowering<InitReturnOp>,
                ReturnOpLowering<HIR::ReturnOp>, GlobalFuncOpConversionPattern,
                CallOpConversionPattern, BinOpConversionPattern,
-               BinAssignOpConversionPattern, InitModuleOpConversionPattern,
-               GetItemOpConversionPattern, SetItemOpConversionPattern,
-               DelItemOpConversionPattern, ContainsOpConversionPattern,
-               GetAttributeOpConversionPattern, SetAttrOpConversionPattern,
-               BuildClassOpConversionPattern>(&getContext());
+               BinAssignOpConversionPattern, GetItemOpConversionPattern,
+               SetItemOpConversionPattern, DelItemOpConversionPattern,
+               ContainsOpConversionPattern, GetAttributeOpConversionPattern,
+               SetAttrOpConversionPattern, BuildClassOpConversionPattern>(
+      &getContext());
+  patterns.add<InitModuleOpConversionPattern>(&getContext(), lazyModules);
   if (failed(
           applyPartialConversion(getOperation(), target, std::move(patterns))))
     return signalPassFailure();
@@ -127,6 +127,11 @@ Value CodeGenState::createRuntimeCall(Location loc, OpBuilder& builder,
     // TODO: Set allockind("alloc,zeroed") allocsize(0) LLVM attributes once
     // supported upstream.
     break;
+  case Runtime::pylir_exception_alloc:
+    returnType = m_objectPtrType;
+    argumentTypes = {m_objectPtrType, m_typeConverter.getIndexType()};
+    functionName = "pylir_exception_alloc";
+    break;
   case Runtime::mp_init_u64:
     returnType = LLVM::LLVMVoidType::get(context);
     argumentTypes = {m_objectPtrType, builder.getI64Type()};
@@ -145,12 +150,30 @@ Value CodeGenState::createRuntimeCall(Location loc, OpBuilder& builder,
     functionName = "mp_get_i64";
     passThroughAttributes = {"gc-leaf-function", "nounwind"};
     break;
+  case Runtime::mp_count_bits:
+    returnType = abi.getInt(context);
+    argumentTypes = {m_objectPtrType};
+    functionName = "mp_count_bits";
+    passThroughAttributes = {"gc-leaf-function", "nounwind"};
+    break;
   case Runtime::pylir_str_hash:
     returnType = m_typeConverter.getIndexType();
     argumentTypes = {m_objectPtrType};
     functionName = "pylir_str_hash";
     passThroughAttributes = {"nounwind"};
     break;
+  case Runtime::pylir_int_hash:
+    returnType = m_typeConverter.getIndexType();
+    argumentTypes = {m_objectPtrType};
+    functionName = "pylir_int_hash";
+    passThroughAttributes = {"gc-leaf-function", "nounwind"};
+    break;
+  case Runtime::pylir_int_to_str:
+    returnType = pointerType;
+    argumentTypes = {m_objectPtrType, m_objectPtrType, m_objectPtrType};
+    functionName = "pylir_int_to_str";
+    passThroughAttributes = {"gc-leaf-function", "nounwind"};
+    break;
   case Runtime::pylir_print:
     returnType = LLVM::LLVMVoidType::get(context);
     argumentTypes = {m_objectPtrType};
@@ -163,6 +186,18 @@ Value CodeGenState::createRuntimeCall(Location loc, OpBuilder& builder,
     functionName = "pylir_raise";
     passThroughAttributes = {"noreturn"};
     break;
+  case Runtime::pylir_raise_pooled:
+    returnType = LLVM::LLVMVoidType::get(context);
+    argumentTypes = {m_objectPtrType};
+    functionName = "pylir_raise_pooled";
+    passThroughAttributes = {"noreturn"};
+    break;
+  case Runtime::pylir_exception_release:
+    returnType = LLVM::LLVMVoidType::get(context);
+    argumentTypes = {m_objectPtrType};
+    functionName = "pylir_exception_release";
+    passThroughAttributes = {"gc-leaf-function", "nounwind"};
+    break;
   case Runtime::mp_init:
     returnType = LLVM::LLVMVoidType::get(context);
     argumentTypes = {m_objectPtrType};
@@ -178,20 +213,6 @@ Value CodeGenState::createRuntimeCall(Location loc, OpBuilder& builder,
     functionName = "mp_unpack";
     passThroughAttributes = {"gc-leaf-function", "nounwind"};
     break;
-  case Runtime::mp_radix_size_overestimate:
-    returnType = LLVM::LLVMVoidType::get(context);
-    argumentTypes = {m_objectPtrType, abi.getInt(context), m_objectPtrType};
-    functionName = "mp_radix_size_overestimate";
-    passThroughAttributes = {"gc-leaf-function", "nounwind"};
-    break;
-  case Runtime::mp_to_radix:
-    returnType = LLVM::LLVMVoidType::get(context);
-    argumentTypes = {m_objectPtrType, pointerType,
-                     m_typeConverter.getIndexType(), m_objectPtrType,
-                     abi.getInt(context)};
-    functionName = "mp_to_radix";
-    passThroughAttributes = {"gc-leaf-function", "nounwind"};
-    break;
   case Runtime::mp_cmp:
     returnType = abi.getInt(context);
     argumentTypes = {m_objectPtrType, m_objectPtrType};
@@ -489,6 +510,9 @@ Value CodeGenState::initialize(Location loc, OpBuilder& builder, DictAttr attr,
       if (layoutType == Mem::LayoutType::String) {
         hash = createRuntimeCall(loc, builder, Runtime::pylir_str_hash,
                                  {keyValue});
+      } else if (layoutType == Mem::LayoutType::Int) {
+        hash = createRuntimeCall(loc, builder, Runtime::pylir_int_hash,
+                                 {keyValue});
       } else if (layoutType == Mem::LayoutType::Object) {
         hash = builder.create<LLVM::PtrToIntOp>(
             loc, m_typeConverter.getIndexType(), keyValue);
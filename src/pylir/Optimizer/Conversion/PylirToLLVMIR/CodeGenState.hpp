@@ -141,20 +141,24 @@ public:
     mp_init_u64,
     mp_init_i64,
     mp_get_i64,
+    mp_count_bits,
     mp_init,
     mp_unpack,
-    mp_radix_size_overestimate,
-    mp_to_radix,
     mp_cmp,
     mp_add,
     pylir_gc_alloc,
+    pylir_exception_alloc,
     pylir_str_hash,
+    pylir_int_hash,
+    pylir_int_to_str,
     pylir_dict_lookup,
     pylir_dict_insert,
     pylir_dict_insert_unique,
     pylir_dict_erase,
     pylir_print,
     pylir_raise,
+    pylir_raise_pooled,
+    pylir_exception_release,
     // NOLINTEND(readability-identifier-naming)
   };
 
@@ -546,6 +546,38 @@ struct IntToIndexOpConversion
   }
 };
 
+struct IntTryToIndexOpConversion
+    : public ConvertPylirOpToLLVMPattern<Py::IntTryToIndexOp> {
+  using ConvertPylirOpToLLVMPattern<
+      Py::IntTryToIndexOp>::ConvertPylirOpToLLVMPattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(Py::IntTryToIndexOp op, OpAdaptor adaptor,
+                  mlir::ConversionPatternRewriter& rewriter) const override {
+    auto mpInt = pyIntModel(rewriter, adaptor.getInput()).mpInt(op.getLoc());
+    mlir::Type indexType = typeConverter.convertType(op.getResult().getType());
+
+    // The magnitude of the integer has to fit into the index type without its
+    // sign bit.
+    mlir::Value bits = codeGenState.createRuntimeCall(
+        op.getLoc(), rewriter, CodeGenState::Runtime::mp_count_bits, mpInt);
+    mlir::Value valid = rewriter.create<mlir::LLVM::ICmpOp>(
+        op.getLoc(), mlir::LLVM::ICmpPredicate::slt, bits,
+        rewriter.create<mlir::LLVM::ConstantOp>(
+            op.getLoc(),
+            mlir::IntegerAttr::get(bits.getType(),
+                                   indexType.getIntOrFloatBitWidth())));
+
+    mlir::Value call = codeGenState.createRuntimeCall(
+        op.getLoc(), rewriter, CodeGenState::Runtime::mp_get_i64, mpInt);
+    if (call.getType() != indexType)
+      call = rewriter.create<mlir::LLVM::TruncOp>(op.getLoc(), indexType, call);
+
+    rewriter.replaceOp(op, {call, valid});
+    return mlir::success();
+  }
+};
+
 struct InitIntAddOpConversion
     : public ConvertPylirOpToLLVMPattern<Mem::InitIntAddOp> {
   using ConvertPylirOpToLLVMPattern<
@@ -777,6 +809,20 @@ struct StrHashOpConversion : public ConvertPylirOpToLLVMPattern<Py::StrHashOp> {
   }
 };
 
+struct IntHashOpConversion : public ConvertPylirOpToLLVMPattern<Py::IntHashOp> {
+  using ConvertPylirOpToLLVMPattern<Py::IntHashOp>::ConvertPylirOpToLLVMPattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(Py::IntHashOp op, OpAdaptor adaptor,
+                  mlir::ConversionPatternRewriter& rewriter) const override {
+    auto hash = codeGenState.createRuntimeCall(
+        op.getLoc(), rewriter, CodeGenState::Runtime::pylir_int_hash,
+        adaptor.getObject());
+    rewriter.replaceOp(op, hash);
+    return mlir::success();
+  }
+};
+
 struct PrintOpConversion : public ConvertPylirOpToLLVMPattern<Py::PrintOp> {
   using ConvertPylirOpToLLVMPattern<Py::PrintOp>::ConvertPylirOpToLLVMPattern;
 
@@ -846,14 +892,33 @@ struct RaiseOpConversion : public ConvertPylirOpToLLVMPattern<Py::RaiseOp> {
   mlir::LogicalResult
   matchAndRewrite(Py::RaiseOp op, OpAdaptor adaptor,
                   mlir::ConversionPatternRewriter& rewriter) const override {
-    codeGenState.createRuntimeCall(op.getLoc(), rewriter,
-                                   CodeGenState::Runtime::pylir_raise,
-                                   {adaptor.getException()});
+    codeGenState.createRuntimeCall(
+        op.getLoc(), rewriter,
+        op->hasAttr(Py::RaiseOp::getPooledAttrName())
+            ? CodeGenState::Runtime::pylir_raise_pooled
+            : CodeGenState::Runtime::pylir_raise,
+        {adaptor.getException()});
     rewriter.replaceOpWithNewOp<mlir::LLVM::UnreachableOp>(op);
     return mlir::success();
   }
 };
 
+struct ReleaseExceptionOpConversion
+    : public ConvertPylirOpToLLVMPattern<Py::ReleaseExceptionOp> {
+  using ConvertPylirOpToLLVMPattern<
+      Py::ReleaseExceptionOp>::ConvertPylirOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(Py::ReleaseExceptionOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter& rewriter) const override {
+    codeGenState.createRuntimeCall(
+        op.getLoc(), rewriter, CodeGenState::Runtime::pylir_exception_release,
+        {adaptor.getException()});
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 struct RaiseExOpConversion : public ConvertPylirOpToLLVMPattern<Py::RaiseExOp> {
   using ConvertPylirOpToLLVMPattern<Py::RaiseExOp>::ConvertPylirOpToLLVMPattern;
 
@@ -1056,9 +1121,17 @@ struct GCAllocObjectConstTypeConversion
         op.getLoc(), adaptor.getTrailingItems(), pointerSize);
     auto inBytes =
         rewriter.create<mlir::LLVM::AddOp>(op.getLoc(), slotSize, instanceSize);
-    auto memory = codeGenState.createRuntimeCall(
-        op.getLoc(), rewriter, CodeGenState::Runtime::pylir_gc_alloc,
-        {inBytes});
+    // Exception objects may be reused from the runtimes exception pool.
+    // See 'ExceptionPoolingPass'.
+    Value memory;
+    if (*layoutType == Mem::LayoutType::BaseException)
+      memory = codeGenState.createRuntimeCall(
+          op.getLoc(), rewriter, CodeGenState::Runtime::pylir_exception_alloc,
+          {adaptor.getTypeObject(), inBytes});
+    else
+      memory = codeGenState.createRuntimeCall(
+          op.getLoc(), rewriter, CodeGenState::Runtime::pylir_gc_alloc,
+          {inBytes});
     auto zeroI8 = rewriter.create<mlir::LLVM::ConstantOp>(
         op.getLoc(), rewriter.getI8Type(), rewriter.getI8IntegerAttr(0));
     rewriter.create<mlir::LLVM::MemsetOp>(op.getLoc(), memory, zeroI8, inBytes,
@@ -1491,31 +1564,10 @@ struct InitStrFromIntOpConversion
                   mlir::ConversionPatternRewriter& rewriter) const override {
     auto string =
         pyStringModel(rewriter, adaptor.getMemory()).buffer(op.getLoc());
-    auto mpIntPtr =
-        pyIntModel(rewriter, adaptor.getInteger()).mpInt(op.getLoc());
-    auto sizePtr = string.size(op.getLoc());
-    auto ten = rewriter.create<mlir::LLVM::ConstantOp>(
-        op.getLoc(), typeConverter.getPlatformABI().getInt(getContext()),
-        rewriter.getI32IntegerAttr(10));
-    codeGenState.createRuntimeCall(
-        op.getLoc(), rewriter,
-        CodeGenState::Runtime::mp_radix_size_overestimate,
-        {mpIntPtr, ten, sizePtr});
-    auto capacity = sizePtr.load(op.getLoc());
     auto array = codeGenState.createRuntimeCall(
-        op.getLoc(), rewriter, CodeGenState::Runtime::malloc, {capacity});
-    codeGenState.createRuntimeCall(op.getLoc(), rewriter,
-                                   CodeGenState::Runtime::mp_to_radix,
-                                   {mpIntPtr, array, capacity, sizePtr, ten});
-
-    // mp_to_radix sadly includes the NULL terminator that it uses in size...
-    mlir::Value size = sizePtr.load(op.getLoc());
-    auto oneI =
-        createIndexAttrConstant(rewriter, op.getLoc(), getIndexType(), 1);
-    size = rewriter.create<mlir::LLVM::SubOp>(op.getLoc(), size, oneI);
-    sizePtr.store(op.getLoc(), size);
-
-    string.capacity(op.getLoc()).store(op.getLoc(), capacity);
+        op.getLoc(), rewriter, CodeGenState::Runtime::pylir_int_to_str,
+        {adaptor.getInteger(), string.size(op.getLoc()),
+         string.capacity(op.getLoc())});
     string.elementPtr(op.getLoc()).store(op.getLoc(), array);
 
     rewriter.replaceOp(op, adaptor.getMemory());
@@ -1884,8 +1936,10 @@ void ConvertPylirToLLVMPass::runOnOperation() {
       GCAllocObjectOpConversion, InitObjectOpConversion, InitListOpConversion,
       InitTupleOpConversion, InitTupleFromListOpConversion, ListLenOpConversion,
       ListGetItemOpConversion, ListSetItemOpConversion, ListResizeOpConversion,
-      RaiseOpConversion, InitIntUnsignedOpConversion, InitIntSignedOpConversion,
+      RaiseOpConversion, ReleaseExceptionOpConversion,
+      InitIntUnsignedOpConversion, InitIntSignedOpConversion,
       ObjectHashOpConversion, ObjectIdOpConversion, StrHashOpConversion,
+      IntHashOpConversion,
       InitFuncOpConversion, InitDictOpConversion, DictTryGetItemOpConversion,
       DictSetItemOpConversion, DictDelItemOpConversion, DictLenOpConversion,
       InitStrOpConversion, PrintOpConversion, InitStrFromIntOpConversion,
@@ -1893,7 +1947,8 @@ void ConvertPylirToLLVMPass::runOnOperation() {
       InvokeOpsConversion<Py::FunctionInvokeOp>, CallOpConversion,
       FunctionCallOpConversion, BoolToI1OpConversion,
       InitTuplePrependOpConversion, InitTupleDropFrontOpConversion,
-      IntToIndexOpConversion, IntCmpOpConversion, InitIntAddOpConversion,
+      IntToIndexOpConversion, IntTryToIndexOpConversion, IntCmpOpConversion,
+      InitIntAddOpConversion,
       UnreachableOpConversion, TypeMROOpConversion,
       ArithmeticSelectOpConversion, TupleContainsOpConversion,
       InitTupleCopyOpConversion, MROLookupOpConversion, TypeSlotsOpConversion,
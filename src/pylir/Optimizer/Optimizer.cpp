@@ -49,11 +49,11 @@ void pylir::registerOptimizationPipelines() {
         pm.addPass(createConvertPylirPyToPylirMemPass());
       });
 
-  mlir::PassPipelineRegistration<>(
+  mlir::PassPipelineRegistration<PylirOptimizeOptions>(
       "pylir-optimize",
       "Optimization pipeline used by the compiler with lowering up until "
       "(exclusive) conversion to LLVM",
-      [](mlir::OpPassManager& pm) {
+      [](mlir::OpPassManager& pm, const PylirOptimizeOptions& optimizeOptions) {
         mlir::OpPassManager* nested = &pm.nestAny();
         nested->addPass(createCanonicalizerPass());
         nested->addPass(createDeadCodeEliminationPass());
@@ -66,40 +66,71 @@ void pylir::registerOptimizationPipelines() {
         nested->addPass(createDeadCodeEliminationPass());
         pm.addPass(createConvertPylirHIRToPylirPyPass());
 
+        auto addSimplificationPasses = [](mlir::OpPassManager& nested) {
+          nested.addPass(createCanonicalizerPass());
+          nested.addPass(mlir::createCSEPass());
+          nested.addPass(pylir::createConditionalsImplicationsPass());
+          nested.addPass(createCanonicalizerPass());
+          nested.addPass(createLoadForwardingPass());
+          nested.addPass(createDeadStoreEliminationPass());
+          nested.addPass(createSROAPass());
+          nested.addPass(createLoopInvariantCodeMotionPass());
+        };
+        auto addExpansionPasses = [](mlir::OpPassManager& nested) {
+          nested.addPass(createDeadCodeEliminationPass());
+          nested.addPass(Py::createExpandPyDialectPass());
+          nested.addPass(createCanonicalizerPass());
+          nested.addPass(mlir::createCSEPass());
+          nested.addPass(createLoadForwardingPass());
+        };
+
         mlir::OpPassManager inlinerNested;
 
         inlinerNested.addPass(createCanonicalizerPass());
         inlinerNested.nestAny().addPass(
             Py::createGlobalLoadStoreEliminationPass());
         inlinerNested.addPass(Py::createFoldGlobalsPass());
+        inlinerNested.addPass(Py::createModuleSnapshotPass());
         inlinerNested.addPass(mlir::createSymbolDCEPass());
-        nested = &inlinerNested.nestAny();
-        nested->addPass(createCanonicalizerPass());
-        nested->addPass(mlir::createCSEPass());
-        nested->addPass(pylir::createConditionalsImplicationsPass());
-        nested->addPass(createCanonicalizerPass());
-        nested->addPass(createLoadForwardingPass());
+        inlinerNested.addPass(Py::createFunctionSpecializationPass());
+        addSimplificationPasses(inlinerNested.nestAny());
 
         // TODO: Upstream MLIR has a bug making SCCP that is not module
         //  level not thread-safe. This is caught by TSAN.
         inlinerNested.addPass(mlir::createSCCPPass());
-        nested = &inlinerNested.nestAny();
-        nested->addPass(createDeadCodeEliminationPass());
-        nested->addPass(Py::createExpandPyDialectPass());
-        nested->addPass(createCanonicalizerPass());
-        nested->addPass(mlir::createCSEPass());
-        nested->addPass(createLoadForwardingPass());
+        addExpansionPasses(inlinerNested.nestAny());
         inlinerNested.addPass(mlir::createSCCPPass());
         nested = &inlinerNested.nestAny();
         nested->addPass(createCanonicalizerPass());
 
+        // Only the functions changed by inlining are optimized after an
+        // inlining iteration. The module level passes above are only run once
+        // inlining makes no more progress with these alone.
+        mlir::OpPassManager functionNested;
+        functionNested.addPass(createCanonicalizerPass());
+        functionNested.addPass(Py::createGlobalLoadStoreEliminationPass());
+        addSimplificationPasses(functionNested);
+        addExpansionPasses(functionNested);
+        functionNested.addPass(createCanonicalizerPass());
+
+        auto printPipeline = [](mlir::OpPassManager& passManager) {
+          std::string pipeline;
+          llvm::raw_string_ostream ss(pipeline);
+          passManager.printAsTextualPipeline(ss);
+          return pipeline;
+        };
+
         Py::InlinerPassOptions options{};
-        std::string pipeline;
-        llvm::raw_string_ostream ss(pipeline);
-        inlinerNested.printAsTextualPipeline(ss);
-        options.m_optimizationPipeline = std::move(pipeline);
+        options.m_optimizationPipeline = printPipeline(inlinerNested);
+        options.m_functionPipeline = printPipeline(functionNested);
+        options.m_threshold = optimizeOptions.inlinerThreshold;
         pm.addPass(Py::createInlinerPass(options));
-        pm.nestAny().addPass(createDeadCodeEliminationPass());
+        pm.addPass(Py::createEscapeSummaryPass());
+        nested = &pm.nestAny();
+        nested->addPass(createDeadCodeEliminationPass());
+        nested->addPass(Py::createLoopIntUnboxingPass());
+        nested->addPass(createCanonicalizerPass());
+        nested->addPass(Py::createExceptionPoolingPass());
         pm.addPass(createConvertPylirPyToPylirMemPass());
       });
 
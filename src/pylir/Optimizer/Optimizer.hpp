@@ -41,13 +41,36 @@ struct PylirLLVMOptions : public mlir::PassPipelineOptions<PylirLLVMOptions> {
   }
 };
 
+/// Pass options for the 'pylir-optimize' pass-pipeline.
+struct PylirOptimizeOptions
+    : public mlir::PassPipelineOptions<PylirOptimizeOptions> {
+  Option<std::uint32_t> inlinerThreshold{
+      *this, "inliner-threshold",
+      llvm::cl::desc("Cost threshold in abstract units up to which call-sites "
+                     "are inlined"),
+      llvm::cl::init(250)};
+
+  PylirOptimizeOptions() = default;
+
+  /// Prints the option struct options in a format suitable for directly
+  /// appending to the pass pipeline name. In other words, this already includes
+  /// the surrounding '{}'.
+  std::string rendered() {
+    std::string rendered;
+    llvm::raw_string_ostream ss(rendered);
+    print(ss);
+    return rendered;
+  }
+};
+
 /// Registers optimization pipelines used in pylir, making them available in the
 /// pass pipeline syntax. There are currently three pipelines registered:
 /// * "pylir-minimum", which does the minimum lowering of the output of pylir,
 /// to a state that can be converted to LLVM.
 /// * "pylir-optimize", which is the full optimization pipeline used by pylir,
 /// also ending in a state that can be
-///     lowered to LLVM.
+///     lowered to LLVM. This pipeline also has the following options:
+///     - "inliner-threshold": cost threshold of the inliner.
 /// * "pylir-llvm", which is capable of taking the lowered output of either of
 /// the two pipelines, and fully lower it to
 ///     the LLVM IR Dialect. This pipeline also has the following options:
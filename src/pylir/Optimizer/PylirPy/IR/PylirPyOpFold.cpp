@@ -922,6 +922,37 @@ mlir::OpFoldResult pylir::Py::IntToIndexOp::fold(FoldAdaptor adaptor) {
   return mlir::IntegerAttr::get(getType(), *optional);
 }
 
+//===--------------------------------------------------------------------------------------------------------------===//
+// IntTryToIndexOp fold
+//===--------------------------------------------------------------------------------------------------------------===//
+
+mlir::LogicalResult pylir::Py::IntTryToIndexOp::fold(
+    FoldAdaptor adaptor, llvm::SmallVectorImpl<mlir::OpFoldResult>& results) {
+  if (auto op = getInput().getDefiningOp<IntFromSignedOp>()) {
+    results.emplace_back(op.getInput());
+    results.emplace_back(mlir::BoolAttr::get(getContext(), true));
+    return mlir::success();
+  }
+
+  auto integer = dyn_cast_or_null<IntAttrInterface>(adaptor.getInput());
+  if (!integer)
+    return mlir::failure();
+
+  std::size_t bitWidth =
+      mlir::DataLayout::closest(*this).getTypeSizeInBits(getResult().getType());
+  auto optional = integer.getInteger().tryGetInteger<std::intmax_t>();
+  if (!optional || !llvm::APInt(sizeof(*optional) * 8, *optional, true)
+                        .isSignedIntN(bitWidth)) {
+    results.emplace_back(mlir::IntegerAttr::get(getResult().getType(), 0));
+    results.emplace_back(mlir::BoolAttr::get(getContext(), false));
+    return mlir::success();
+  }
+  results.emplace_back(
+      mlir::IntegerAttr::get(getResult().getType(), *optional));
+  results.emplace_back(mlir::BoolAttr::get(getContext(), true));
+  return mlir::success();
+}
+
 //===--------------------------------------------------------------------------------------------------------------===//
 // IntCmpOp fold
 //===--------------------------------------------------------------------------------------------------------------===//
@@ -67,6 +67,22 @@ void replaceDictAggregate(
   }
 }
 
+template <class T>
+void replaceTupleAggregate(
+    T op,
+    llvm::function_ref<void(mlir::Attribute, mlir::SideEffects::Resource*,
+                            mlir::Value)>
+        write,
+    mlir::OpBuilder& builder) {
+  // Tuples are immutable and therefore not modelled by any memory resource.
+  for (const auto& iter : llvm::enumerate(op.getArguments()))
+    write(builder.getIndexAttr(iter.index()), nullptr, iter.value());
+
+  auto len = builder.create<mlir::arith::ConstantIndexOp>(
+      op.getLoc(), op.getArguments().size());
+  write(nullptr, nullptr, len);
+}
+
 void destructureSlots(
     pylir::Py::ConstObjectAttrInterface attr,
     llvm::function_ref<void(mlir::Attribute, mlir::SideEffects::Resource*,
@@ -325,6 +341,66 @@ void pylir::Py::MakeListExOp::replaceAggregate(
   replaceListAggregate(*this, write, builder);
 }
 
+//===----------------------------------------------------------------------===//
+// TupleGetItemOp implementation
+//===----------------------------------------------------------------------===//
+
+void pylir::Py::TupleGetItemOp::replaceAggregate(
+    mlir::OpBuilder&, mlir::Attribute key,
+    llvm::function_ref<mlir::Value(mlir::Attribute,
+                                   mlir::SideEffects::Resource*, mlir::Type)>
+        read,
+    llvm::function_ref<void(mlir::Attribute, mlir::SideEffects::Resource*,
+                            mlir::Value)>) {
+  replaceAllUsesWith(read(key, nullptr, getType()));
+}
+
+//===----------------------------------------------------------------------===//
+// TupleLenOp implementation
+//===----------------------------------------------------------------------===//
+
+void pylir::Py::TupleLenOp::replaceAggregate(
+    mlir::OpBuilder&, mlir::Attribute,
+    llvm::function_ref<mlir::Value(mlir::Attribute,
+                                   mlir::SideEffects::Resource*, mlir::Type)>
+        read,
+    llvm::function_ref<void(mlir::Attribute, mlir::SideEffects::Resource*,
+                            mlir::Value)>) {
+  replaceAllUsesWith(read(nullptr, nullptr, getType()));
+}
+
+//===----------------------------------------------------------------------===//
+// MakeTupleOp implementation
+//===----------------------------------------------------------------------===//
+
+mlir::LogicalResult pylir::Py::MakeTupleOp::canParticipateInSROA() {
+  return mlir::success(getIterExpansion().empty());
+}
+
+void pylir::Py::MakeTupleOp::replaceAggregate(
+    mlir::OpBuilder& builder,
+    llvm::function_ref<void(mlir::Attribute, mlir::SideEffects::Resource*,
+                            mlir::Value)>
+        write) {
+  replaceTupleAggregate(*this, write, builder);
+}
+
+//===----------------------------------------------------------------------===//
+// MakeTupleExOp implementation
+//===----------------------------------------------------------------------===//
+
+mlir::LogicalResult pylir::Py::MakeTupleExOp::canParticipateInSROA() {
+  return mlir::success(getIterExpansion().empty());
+}
+
+void pylir::Py::MakeTupleExOp::replaceAggregate(
+    mlir::OpBuilder& builder,
+    llvm::function_ref<void(mlir::Attribute, mlir::SideEffects::Resource*,
+                            mlir::Value)>
+        write) {
+  replaceTupleAggregate(*this, write, builder);
+}
+
 //===----------------------------------------------------------------------===//
 // SROAAttrInterface implementations
 //===----------------------------------------------------------------------===//
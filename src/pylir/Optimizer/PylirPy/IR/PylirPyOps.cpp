@@ -580,6 +580,33 @@ void pylir::Py::UnpackExOp::build(::mlir::OpBuilder& odsBuilder,
 // CallOp implementations
 //===----------------------------------------------------------------------===//
 
+namespace {
+/// Returns true if 'value' is used by 'call' in any other way than as a call
+/// argument known to not be captured by the callee.
+bool callCapturesValue(mlir::CallOpInterface call, mlir::Value value) {
+  auto noCapture = call->getAttrOfType<mlir::DenseI32ArrayAttr>(
+      pylir::Py::noCaptureOperandsAttrName);
+  mlir::Operation::operand_range arguments = call.getArgOperands();
+  for (mlir::OpOperand& operand : call->getOpOperands()) {
+    if (operand.get() != value)
+      continue;
+
+    unsigned index = operand.getOperandNumber();
+    if (!noCapture || index < arguments.getBeginOperandIndex() ||
+        index >= arguments.getBeginOperandIndex() + arguments.size())
+      return true;
+    if (!llvm::is_contained(noCapture.asArrayRef(),
+                            index - arguments.getBeginOperandIndex()))
+      return true;
+  }
+  return false;
+}
+} // namespace
+
+bool pylir::Py::CallOp::capturesValue(mlir::Value value) {
+  return callCapturesValue(*this, value);
+}
+
 mlir::CallInterfaceCallable pylir::Py::CallOp::getCallableForCallee() {
   return getCalleeAttr();
 }
@@ -602,6 +629,10 @@ void pylir::Py::CallOp::setCalleeFromCallable(
 // InvokeOp implementations
 //===----------------------------------------------------------------------===//
 
+bool pylir::Py::InvokeOp::capturesValue(mlir::Value value) {
+  return callCapturesValue(*this, value);
+}
+
 mlir::CallInterfaceCallable pylir::Py::InvokeOp::getCallableForCallee() {
   return getCalleeAttr();
 }
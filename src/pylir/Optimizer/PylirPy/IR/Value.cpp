@@ -4,6 +4,7 @@
 
 #include "Value.hpp"
 
+#include <mlir/Interfaces/CallInterfaces.h>
 #include <mlir/Interfaces/FunctionInterfaces.h>
 
 #include <pylir/Optimizer/PylirPy/Interfaces/KnownTypeObjectInterface.hpp>
@@ -20,6 +21,31 @@ mlir::OpFoldResult pylir::Py::getTypeOf(mlir::Value value) {
   if (auto op = value.getDefiningOp<pylir::Py::KnownTypeObjectInterface>())
     return op.getKnownTypeObject();
 
+  if (auto blockArg = dyn_cast<BlockArgument>(value)) {
+    // See 'isUnbound' below for block arguments of unlinked blocks.
+    Block* owner = blockArg.getOwner();
+    if (!owner->getParent() || !owner->isEntryBlock())
+      return nullptr;
+
+    auto function = dyn_cast<FunctionOpInterface>(owner->getParentOp());
+    if (!function || blockArg.getArgNumber() >= function.getNumArguments())
+      return nullptr;
+
+    return function.getArgAttr(blockArg.getArgNumber(), knownTypeArgAttrName);
+  }
+
+  if (auto call = value.getDefiningOp<CallOpInterface>()) {
+    auto resultTypes = call->getAttrOfType<ArrayAttr>(knownResultTypesAttrName);
+    unsigned resultNumber = cast<OpResult>(value).getResultNumber();
+    if (!resultTypes || resultNumber >= resultTypes.size())
+      return nullptr;
+
+    Attribute type = resultTypes[resultNumber];
+    if (isa<UnitAttr>(type))
+      return nullptr;
+    return type;
+  }
+
   return nullptr;
 }
 
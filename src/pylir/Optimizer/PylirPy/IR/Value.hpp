@@ -11,6 +11,25 @@
 #include "PylirPyOps.hpp"
 
 namespace pylir::Py {
+
+/// Name of the argument attribute of functions containing the type object of
+/// every value passed to the argument.
+constexpr llvm::StringLiteral knownTypeArgAttrName = "py.type";
+
+/// Name of the discardable attribute of call operations containing an array
+/// with the type object of every result of the call. Results of unknown type
+/// are denoted by a 'UnitAttr'.
+constexpr llvm::StringLiteral knownResultTypesAttrName = "py.result_types";
+
+/// Name of the argument attribute of functions marking arguments that are
+/// neither stored, returned nor otherwise captured by the function.
+constexpr llvm::StringLiteral noCaptureArgAttrName = "py.no_capture";
+
+/// Name of the discardable attribute of call operations containing the indices
+/// of the call arguments that are not captured by the callee.
+constexpr llvm::StringLiteral noCaptureOperandsAttrName =
+    "py.no_capture_operands";
+
 /// Returns the type of the value. This may either be a value referring to the
 /// type object or an attribute that is the type object. This operation may also
 /// fail in which case it is a null value.
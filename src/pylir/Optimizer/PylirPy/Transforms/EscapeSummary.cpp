@@ -0,0 +1,213 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Analysis/CallGraph.h>
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/SymbolTable.h>
+#include <mlir/Interfaces/CallInterfaces.h>
+#include <mlir/Interfaces/ControlFlowInterfaces.h>
+#include <mlir/Pass/Pass.h>
+
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/SCCIterator.h>
+
+#include <pylir/Optimizer/Interfaces/CaptureInterface.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/PylirPy/IR/Value.hpp>
+
+#include "Passes.hpp"
+
+namespace pylir::Py {
+#define GEN_PASS_DEF_ESCAPESUMMARYPASS
+#include "pylir/Optimizer/PylirPy/Transforms/Passes.h.inc"
+} // namespace pylir::Py
+
+using namespace mlir;
+using namespace pylir;
+using namespace pylir::Py;
+
+namespace {
+
+/// Computes for every function which of its arguments are captured, meaning
+/// stored, returned or passed to an operation that may capture them.
+///
+/// Functions are processed bottom-up in the call graph, allowing the summary of
+/// a callee to be used when analysing a call within its caller. Functions
+/// within the same SCC optimistically assume that none of their arguments are
+/// captured, which is then refined until a fixpoint is reached.
+///
+/// The results are attached to the arguments of functions and to the call
+/// sites of the functions, where 'CaptureInterface' makes them available to
+/// function local analyses such as 'EscapeAnalysis'.
+class EscapeSummaryPass
+    : public pylir::Py::impl::EscapeSummaryPassBase<EscapeSummaryPass> {
+protected:
+  void runOnOperation() override;
+
+private:
+  /// Set bits denote arguments that are not captured by a function.
+  llvm::DenseMap<FuncOp, llvm::BitVector> m_summaries;
+
+  /// Returns the function called by 'call' if it is a direct call.
+  FuncOp getCallee(CallOpInterface call, SymbolTable& symbolTable);
+
+  /// Returns true if 'arg' may be captured within its function.
+  bool isCaptured(BlockArgument arg, SymbolTable& symbolTable);
+
+  /// Computes the summaries of all functions in 'scc'.
+  void summarizeSCC(ArrayRef<FuncOp> scc, SymbolTable& symbolTable);
+
+public:
+  using Base::Base;
+};
+
+FuncOp EscapeSummaryPass::getCallee(CallOpInterface call,
+                                    SymbolTable& symbolTable) {
+  auto callee = call.getCallableForCallee().dyn_cast<SymbolRefAttr>();
+  if (!callee)
+    return nullptr;
+  return symbolTable.lookup<FuncOp>(callee.getRootReference());
+}
+
+bool EscapeSummaryPass::isCaptured(BlockArgument arg,
+                                   SymbolTable& symbolTable) {
+  SmallVector<Value> worklist{arg};
+  llvm::SmallPtrSet<Value, 8> seen{arg};
+  while (!worklist.empty()) {
+    Value value = worklist.pop_back_val();
+    for (OpOperand& use : value.getUses()) {
+      Operation* user = use.getOwner();
+      if (auto branch = dyn_cast<BranchOpInterface>(user)) {
+        if (std::optional<BlockArgument> blockArg =
+                branch.getSuccessorBlockArgument(use.getOperandNumber())) {
+          if (seen.insert(*blockArg).second)
+            worklist.push_back(*blockArg);
+          continue;
+        }
+      }
+
+      // Calls are handled using the summaries of the callee instead of
+      // 'CaptureInterface', as the attributes on the call may not be up to date
+      // yet.
+      if (auto call = dyn_cast<CallOpInterface>(user)) {
+        FuncOp callee = getCallee(call, symbolTable);
+        auto summary = m_summaries.find(callee);
+        if (summary == m_summaries.end())
+          return true;
+
+        Operation::operand_range arguments = call.getArgOperands();
+        unsigned index = use.getOperandNumber();
+        if (index < arguments.getBeginOperandIndex() ||
+            index >= arguments.getBeginOperandIndex() + arguments.size())
+          return true;
+        if (!summary->second.test(index - arguments.getBeginOperandIndex()))
+          return true;
+        continue;
+      }
+
+      // Note that returning a value is also a capture, as 'py.return' does not
+      // implement 'CaptureInterface'.
+      auto capture = dyn_cast<CaptureInterface>(user);
+      if (!capture || capture.capturesValue(value))
+        return true;
+    }
+  }
+  return false;
+}
+
+void EscapeSummaryPass::summarizeSCC(ArrayRef<FuncOp> scc,
+                                     SymbolTable& symbolTable) {
+  for (FuncOp funcOp : scc)
+    m_summaries[funcOp].resize(funcOp.getNumArguments(), true);
+
+  // Summaries only ever change from not captured to captured, guaranteeing
+  // termination.
+  bool changed;
+  do {
+    changed = false;
+    for (FuncOp funcOp : scc) {
+      llvm::BitVector& summary = m_summaries[funcOp];
+      for (BlockArgument arg : funcOp.getArguments()) {
+        if (!summary.test(arg.getArgNumber()) ||
+            !isCaptured(arg, symbolTable))
+          continue;
+
+        summary.reset(arg.getArgNumber());
+        changed = true;
+      }
+    }
+  } while (changed);
+}
+
+void EscapeSummaryPass::runOnOperation() {
+  SymbolTable symbolTable(getOperation());
+  auto& callGraph = getAnalysis<CallGraph>();
+
+  // SCCs are visited in post order, meaning callees before callers.
+  for (auto iter = llvm::scc_begin(&std::as_const(callGraph)); !iter.isAtEnd();
+       ++iter) {
+    SmallVector<FuncOp> scc;
+    for (const CallGraphNode* node : *iter) {
+      if (node->isExternal())
+        continue;
+      auto funcOp = dyn_cast<FuncOp>(node->getCallableRegion()->getParentOp());
+      if (funcOp && !funcOp.isExternal())
+        scc.push_back(funcOp);
+    }
+    summarizeSCC(scc, symbolTable);
+  }
+
+  bool changed = false;
+  auto unit = UnitAttr::get(&getContext());
+  for (auto& [funcOp, summary] : m_summaries) {
+    for (unsigned i : llvm::seq<unsigned>(0, funcOp.getNumArguments())) {
+      bool annotated = funcOp.getArgAttr(i, noCaptureArgAttrName) != nullptr;
+      if (summary.test(i) == annotated)
+        continue;
+
+      changed = true;
+      if (annotated) {
+        funcOp.removeArgAttr(i, noCaptureArgAttrName);
+        continue;
+      }
+      funcOp.setArgAttr(i, noCaptureArgAttrName, unit);
+      m_argumentsNotCaptured++;
+    }
+  }
+
+  getOperation()->walk([&](CallOpInterface call) {
+    SmallVector<std::int32_t> noCapture;
+    if (FuncOp callee = getCallee(call, symbolTable)) {
+      auto summary = m_summaries.find(callee);
+      if (summary != m_summaries.end())
+        for (unsigned i :
+             llvm::seq<unsigned>(0, call.getArgOperands().size()))
+          if (i < summary->second.size() && summary->second.test(i))
+            noCapture.push_back(i);
+    }
+
+    auto attr =
+        call->getAttrOfType<DenseI32ArrayAttr>(noCaptureOperandsAttrName);
+    if (noCapture.empty()) {
+      if (attr) {
+        call->removeAttr(noCaptureOperandsAttrName);
+        changed = true;
+      }
+      return;
+    }
+
+    auto newAttr = DenseI32ArrayAttr::get(&getContext(), noCapture);
+    if (attr == newAttr)
+      return;
+    call->setAttr(noCaptureOperandsAttrName, newAttr);
+    m_callSitesAnnotated++;
+    changed = true;
+  });
+
+  m_summaries.clear();
+  if (!changed)
+    markAllAnalysesPreserved();
+}
+
+} // namespace
@@ -0,0 +1,125 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Analysis/Liveness.h>
+#include <mlir/Pass/Pass.h>
+
+#include <llvm/ADT/SetVector.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+#include "Passes.hpp"
+#include "Util/ExceptionRewriter.hpp"
+
+namespace pylir::Py {
+#define GEN_PASS_DEF_EXCEPTIONPOOLINGPASS
+#include "pylir/Optimizer/PylirPy/Transforms/Passes.h.inc"
+} // namespace pylir::Py
+
+using namespace mlir;
+using namespace pylir;
+using namespace pylir::Py;
+
+namespace {
+
+/// Enables the runtime to reuse exception objects that are raised and caught
+/// without being retained, which is typical for exceptions used as control
+/// flow such as 'StopIteration'. Raise sites of such exceptions are marked as
+/// pooled and exception handlers not retaining the exception release it once
+/// it is no longer used.
+class ExceptionPoolingPass
+    : public pylir::Py::impl::ExceptionPoolingPassBase<ExceptionPoolingPass> {
+protected:
+  void runOnOperation() override;
+
+private:
+  /// Inserts 'py.releaseException' operations for the exception object caught
+  /// by 'handler' on every edge where it stops being live.
+  bool releaseAfterLastUse(Block* handler, Liveness& liveness);
+
+public:
+  using Base::Base;
+};
+
+bool ExceptionPoolingPass::releaseAfterLastUse(Block* handler,
+                                               Liveness& liveness) {
+  Value exception = handler->getArgument(0);
+  // Running the pass a second time must not release the object twice.
+  if (llvm::any_of(exception.getUsers(), [](Operation* user) {
+        return isa<ReleaseExceptionOp>(user);
+      }))
+    return false;
+
+  SmallVector<OpBuilder::InsertPoint> releasePoints;
+  SmallVector<Block*> worklist{handler};
+  llvm::SmallPtrSet<Block*, 8> seen{handler};
+  while (!worklist.empty()) {
+    Block* block = worklist.pop_back_val();
+    Operation* terminator = block->getTerminator();
+    // Reraising hands the exception object back to the runtime.
+    if (llvm::is_contained(terminator->getOperands(), exception))
+      continue;
+
+    if (terminator->getNumSuccessors() == 0) {
+      releasePoints.emplace_back(block, Block::iterator(terminator));
+      continue;
+    }
+
+    for (Block* successor : terminator->getSuccessors()) {
+      if (liveness.getLiveness(successor) &&
+          liveness.getLiveness(successor)->isLiveIn(exception)) {
+        if (seen.insert(successor).second)
+          worklist.push_back(successor);
+        continue;
+      }
+
+      // The exception is dead on entry of 'successor'. Releasing it at its
+      // start is only correct if it is not reachable through any other path.
+      if (successor->getSinglePredecessor() == block)
+        releasePoints.emplace_back(successor, successor->begin());
+    }
+  }
+
+  OpBuilder builder(&getContext());
+  for (OpBuilder::InsertPoint insertPoint : releasePoints) {
+    builder.restoreInsertionPoint(insertPoint);
+    builder.create<ReleaseExceptionOp>(exception.getLoc(), exception);
+    m_exceptionsReleased++;
+  }
+  return !releasePoints.empty();
+}
+
+void ExceptionPoolingPass::runOnOperation() {
+  bool changed = false;
+  llvm::SetVector<Block*> handlers;
+  getOperation()->walk([&](Operation* op) {
+    if (auto exceptionHandling = dyn_cast<ExceptionHandlingInterface>(op)) {
+      handlers.insert(exceptionHandling.getExceptionPath());
+      return;
+    }
+
+    auto raiseOp = dyn_cast<RaiseOp>(op);
+    if (!raiseOp || raiseOp->hasAttr(RaiseOp::getPooledAttrName()) ||
+        !raisesUnretainedException(raiseOp))
+      return;
+
+    raiseOp->setAttr(RaiseOp::getPooledAttrName(),
+                     UnitAttr::get(&getContext()));
+    m_raiseSitesPooled++;
+    changed = true;
+  });
+
+  auto nonRetaining = llvm::to_vector(
+      llvm::make_filter_range(handlers, isNonRetainingExceptionHandler));
+  if (!nonRetaining.empty()) {
+    Liveness liveness(getOperation());
+    for (Block* handler : nonRetaining)
+      changed = releaseAfterLastUse(handler, liveness) || changed;
+  }
+
+  if (!changed)
+    markAllAnalysesPreserved();
+}
+
+} // namespace
@@ -0,0 +1,317 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/SymbolTable.h>
+#include <mlir/Interfaces/CallInterfaces.h>
+#include <mlir/Pass/Pass.h>
+
+#include <llvm/ADT/MapVector.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyDialect.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/PylirPy/IR/Value.hpp>
+
+#include "Passes.hpp"
+
+namespace pylir::Py {
+#define GEN_PASS_DEF_FUNCTIONSPECIALIZATIONPASS
+#include "pylir/Optimizer/PylirPy/Transforms/Passes.h.inc"
+} // namespace pylir::Py
+
+using namespace mlir;
+using namespace pylir;
+using namespace pylir::Py;
+
+namespace {
+
+/// Name of the discardable attribute of a specialized function containing the
+/// name of the function it was cloned from.
+constexpr llvm::StringLiteral specializationOfAttrName =
+    "py.specialization_of";
+
+/// Propagates the type objects of arguments from call sites into the
+/// functions being called and of returned values back to the call sites.
+///
+/// Private functions only ever called directly, whose call sites all agree on
+/// the type of an argument, have that type attached to the argument in place.
+/// Otherwise, a clone of the function is created for every signature of known
+/// argument types observed at call sites, up to a limit. Folders then use these
+/// types to resolve 'py.typeOf' and subsequently the method lookups and calls
+/// of the dynamic dispatch.
+class FunctionSpecializationPass
+    : public pylir::Py::impl::FunctionSpecializationPassBase<
+          FunctionSpecializationPass> {
+protected:
+  void runOnOperation() override;
+
+private:
+  struct FunctionUses {
+    llvm::SmallVector<CallOpInterface> calls;
+    /// True if the function is referenced by anything but the callee of a
+    /// call. Not all call sites are known in that case.
+    bool escapes = false;
+  };
+
+  /// Collects the uses of every function within the module.
+  llvm::MapVector<FuncOp, FunctionUses> collectUses(SymbolTable& symbolTable);
+
+  /// Returns the type objects of the arguments of 'call'. Arguments whose
+  /// types are unknown are denoted by a 'UnitAttr'.
+  ArrayAttr getSignature(CallOpInterface call);
+
+  /// Attaches the types that all 'calls' agree on to the arguments of
+  /// 'funcOp'. Returns true if any types were attached.
+  bool inferArgumentTypes(FuncOp funcOp, ArrayRef<CallOpInterface> calls);
+
+  /// Attaches the types of the values returned by 'funcOp' to the results of
+  /// 'calls'. Returns true if any types were attached.
+  bool inferResultTypes(FuncOp funcOp, ArrayRef<CallOpInterface> calls);
+
+  /// Redirects 'call' to a clone of 'funcOp' specialized for the known types of
+  /// its arguments. Returns true if 'call' was changed.
+  bool specialize(CallOpInterface call, FuncOp funcOp,
+                  SymbolTable& symbolTable);
+
+  /// Specializations of a function keyed by the signature they were created
+  /// for.
+  llvm::DenseMap<std::pair<FuncOp, ArrayAttr>, FuncOp> m_specializations;
+  llvm::DenseMap<FuncOp, std::size_t> m_specializationCount;
+  llvm::DenseMap<FuncOp, std::size_t> m_functionSizes;
+
+public:
+  using Base::Base;
+};
+
+llvm::MapVector<FuncOp, FunctionSpecializationPass::FunctionUses>
+FunctionSpecializationPass::collectUses(SymbolTable& symbolTable) {
+  llvm::MapVector<FuncOp, FunctionUses> result;
+  for (auto funcOp : getOperation().getOps<FuncOp>())
+    result[funcOp];
+
+  std::optional<SymbolTable::UseRange> uses =
+      SymbolTable::getSymbolUses(getOperation().getBodyRegion());
+  if (!uses) {
+    // Unknown operations may reference any symbol.
+    for (auto& [funcOp, functionUses] : result)
+      functionUses.escapes = true;
+    return result;
+  }
+
+  for (const SymbolTable::SymbolUse& use : *uses) {
+    auto funcOp = symbolTable.lookup<FuncOp>(
+        use.getSymbolRef().getRootReference().getValue());
+    if (!funcOp)
+      continue;
+
+    FunctionUses& functionUses = result[funcOp];
+    auto call = dyn_cast<CallOpInterface>(use.getUser());
+    if (!call || call.getCallableForCallee().dyn_cast<SymbolRefAttr>() !=
+                     use.getSymbolRef()) {
+      functionUses.escapes = true;
+      continue;
+    }
+    functionUses.calls.push_back(call);
+  }
+  return result;
+}
+
+ArrayAttr FunctionSpecializationPass::getSignature(CallOpInterface call) {
+  auto unknown = UnitAttr::get(&getContext());
+  SmallVector<Attribute> types;
+  for (Value operand : call.getArgOperands()) {
+    OpFoldResult type = getTypeOf(operand);
+    types.push_back(type && type.is<Attribute>() ? type.get<Attribute>()
+                                                 : unknown);
+  }
+  return ArrayAttr::get(&getContext(), types);
+}
+
+bool FunctionSpecializationPass::inferArgumentTypes(
+    FuncOp funcOp, ArrayRef<CallOpInterface> calls) {
+  if (calls.empty())
+    return false;
+
+  SmallVector<Attribute> types = llvm::to_vector(getSignature(calls.front()));
+  for (CallOpInterface call : calls.drop_front()) {
+    for (auto [type, other] : llvm::zip(types, getSignature(call)))
+      if (type != other)
+        type = UnitAttr::get(&getContext());
+  }
+
+  bool changed = false;
+  for (auto [index, type] : llvm::enumerate(types)) {
+    if (isa<UnitAttr>(type) || funcOp.getArgAttr(index, knownTypeArgAttrName))
+      continue;
+
+    funcOp.setArgAttr(index, knownTypeArgAttrName, type);
+    m_argumentsInferred++;
+    changed = true;
+  }
+  return changed;
+}
+
+bool FunctionSpecializationPass::inferResultTypes(
+    FuncOp funcOp, ArrayRef<CallOpInterface> calls) {
+  if (calls.empty() || funcOp.isExternal())
+    return false;
+
+  std::optional<SmallVector<Attribute>> types;
+  funcOp.walk([&](ReturnOp returnOp) {
+    SmallVector<Attribute> returned;
+    for (Value value : returnOp.getArguments()) {
+      OpFoldResult type = getTypeOf(value);
+      returned.push_back(type && type.is<Attribute>()
+                             ? type.get<Attribute>()
+                             : UnitAttr::get(&getContext()));
+    }
+    if (!types) {
+      types = std::move(returned);
+      return;
+    }
+    for (auto [type, other] : llvm::zip(*types, returned))
+      if (type != other)
+        type = UnitAttr::get(&getContext());
+  });
+  if (!types ||
+      llvm::all_of(*types, [](Attribute type) { return isa<UnitAttr>(type); }))
+    return false;
+
+  auto resultTypes = ArrayAttr::get(&getContext(), *types);
+  bool changed = false;
+  for (CallOpInterface call : calls) {
+    if (call->getAttr(knownResultTypesAttrName) == resultTypes)
+      continue;
+
+    call->setAttr(knownResultTypesAttrName, resultTypes);
+    m_resultsInferred++;
+    changed = true;
+  }
+  return changed;
+}
+
+bool FunctionSpecializationPass::specialize(CallOpInterface call, FuncOp funcOp,
+                                            SymbolTable& symbolTable) {
+  // Calls to existing specializations are specialized starting from the
+  // original function, as more argument types may have become known since.
+  FuncOp origin = funcOp;
+  if (auto originName =
+          funcOp->getAttrOfType<StringAttr>(specializationOfAttrName))
+    if (auto originOp = symbolTable.lookup<FuncOp>(originName))
+      origin = originOp;
+
+  if (origin.isExternal())
+    return false;
+
+  ArrayAttr signature = getSignature(call);
+  // Only specialize if a type becomes known to the callee that it does not
+  // know yet and is also used to determine the type of the argument. This
+  // mirrors the arguments that the inliner considers beneficial to know.
+  bool profitable = false;
+  for (auto [index, type] : llvm::enumerate(signature)) {
+    if (isa<UnitAttr>(type) ||
+        funcOp.getArgAttr(index, knownTypeArgAttrName) == type ||
+        origin.getArgAttr(index, knownTypeArgAttrName))
+      continue;
+
+    if (llvm::any_of(origin.getArgument(index).getUsers(),
+                     [](Operation* user) { return isa<TypeOfOp>(user); })) {
+      profitable = true;
+      break;
+    }
+  }
+  if (!profitable)
+    return false;
+
+  FuncOp& specialization = m_specializations[{origin, signature}];
+  if (!specialization) {
+    std::size_t& size = m_functionSizes[origin];
+    if (size == 0)
+      origin->walk([&](Operation*) { size++; });
+    if (size > m_sizeThreshold ||
+        m_specializationCount[origin] >= m_maxSpecializations)
+      return false;
+
+    m_specializationCount[origin]++;
+    specialization = origin.clone();
+    specialization.setPrivate();
+    specialization.setSymName((origin.getSymName() + "$spec").str());
+    specialization->setAttr(specializationOfAttrName, origin.getSymNameAttr());
+    for (auto [index, type] : llvm::enumerate(signature))
+      if (!isa<UnitAttr>(type))
+        specialization.setArgAttr(index, knownTypeArgAttrName, type);
+
+    symbolTable.insert(specialization, std::next(origin->getIterator()));
+    m_functionsSpecialized++;
+  }
+  if (specialization == funcOp)
+    return false;
+
+  call.setCalleeFromCallable(FlatSymbolRefAttr::get(specialization));
+  m_callsSpecialized++;
+  return true;
+}
+
+void FunctionSpecializationPass::runOnOperation() {
+  SymbolTable symbolTable(getOperation());
+
+  // Recreate the map of existing specializations from previous runs of the
+  // pass.
+  for (auto funcOp : getOperation().getOps<FuncOp>()) {
+    auto originName =
+        funcOp->getAttrOfType<StringAttr>(specializationOfAttrName);
+    if (!originName)
+      continue;
+    auto origin = symbolTable.lookup<FuncOp>(originName);
+    if (!origin)
+      continue;
+
+    auto unknown = UnitAttr::get(&getContext());
+    SmallVector<Attribute> signature;
+    for (unsigned i = 0; i < funcOp.getNumArguments(); i++) {
+      Attribute type = funcOp.getArgAttr(i, knownTypeArgAttrName);
+      signature.push_back(type ? type : unknown);
+    }
+    m_specializations[{origin, ArrayAttr::get(&getContext(), signature)}] =
+        funcOp;
+    m_specializationCount[origin]++;
+  }
+
+  // Types attached in one iteration may make the types of arguments and
+  // returned values in other functions known. Iterate until no more changes
+  // are made. This terminates as types are only ever attached and the amount
+  // of specializations is limited.
+  bool changed = false;
+  bool changedThisIteration;
+  do {
+    changedThisIteration = false;
+    llvm::MapVector<FuncOp, FunctionUses> uses = collectUses(symbolTable);
+    for (auto& [funcOp, functionUses] : uses) {
+      if (!funcOp.isPrivate() || functionUses.escapes)
+        continue;
+
+      changedThisIteration |= inferArgumentTypes(funcOp, functionUses.calls);
+    }
+
+    for (auto& [funcOp, functionUses] : uses)
+      for (CallOpInterface call : functionUses.calls)
+        changedThisIteration |= specialize(call, funcOp, symbolTable);
+
+    if (changedThisIteration)
+      uses = collectUses(symbolTable);
+
+    for (auto& [funcOp, functionUses] : uses)
+      changedThisIteration |= inferResultTypes(funcOp, functionUses.calls);
+
+    changed |= changedThisIteration;
+  } while (changedThisIteration);
+
+  m_specializations.clear();
+  m_specializationCount.clear();
+  m_functionSizes.clear();
+  if (!changed)
+    markAllAnalysesPreserved();
+}
+
+} // namespace
@@ -2,6 +2,7 @@
 //  See https://llvm.org/LICENSE.txt for license information.
 //  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include <mlir/Analysis/CallGraph.h>
 #include <mlir/IR/Attributes.h>
 #include <mlir/IR/Block.h>
 #include <mlir/IR/Dominance.h>
@@ -14,7 +15,9 @@
 
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SCCIterator.h>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SetVector.h>
 #include <llvm/ADT/SparseBitVector.h>
 #include <llvm/Support/Debug.h>
 
@@ -46,6 +49,7 @@ using namespace pylir;
 
 class InlinerPass : public Py::impl::InlinerPassBase<InlinerPass> {
   mlir::OpPassManager m_passManager;
+  std::optional<mlir::OpPassManager> m_functionPassManager;
 
 protected:
   mlir::LogicalResult initialize(mlir::MLIRContext*) override {
@@ -54,6 +58,14 @@ protected:
       return temp;
 
     m_passManager = std::move(*temp);
+    if (m_functionPipeline.empty())
+      return mlir::success();
+
+    temp = mlir::parsePassPipeline(m_functionPipeline);
+    if (mlir::failed(temp))
+      return temp;
+
+    m_functionPassManager = std::move(*temp);
     return mlir::success();
   }
 
@@ -66,11 +78,18 @@ public:
     Base::getDependentDialects(registry);
     // Above initialize will signal the error properly. This also gets called
     // before `initialize`, hence we can't use m_passManager here.
-    auto temp = mlir::parsePassPipeline(m_optimizationPipeline, llvm::nulls());
-    if (mlir::failed(temp))
-      return;
+    for (llvm::StringRef pipeline :
+         {llvm::StringRef(m_optimizationPipeline),
+          llvm::StringRef(m_functionPipeline)}) {
+      if (pipeline.empty())
+        continue;
+
+      auto temp = mlir::parsePassPipeline(pipeline, llvm::nulls());
+      if (mlir::failed(temp))
+        continue;
 
-    temp->getDependentDialects(registry);
+      temp->getDependentDialects(registry);
+    }
   }
 };
 
@@ -313,6 +332,7 @@ class Inliner {
   std::uint16_t m_cyclePenalty;
   mlir::AnalysisManager m_analysisManager;
   CallSiteQueue m_queue;
+  InlineCost m_inlineCost;
 
   EdgeHistories m_edgeHistories;
 
@@ -321,6 +341,16 @@ class Inliner {
   grade(mlir::CallOpInterface call, mlir::CallableOpInterface callee,
         mlir::SymbolTableCollection& collection);
 
+  // Inlines callsites from the queue until it is empty. Adds the closest
+  // isolated-from-above operations of all callsites inlined to 'changed'.
+  void inlineQueue(llvm::SetVector<mlir::Operation*>& changed,
+                   mlir::SymbolTableCollection& collection,
+                   llvm::function_ref<void(mlir::CallOpInterface,
+                                           mlir::CallableOpInterface)>
+                       handleCallOp,
+                   mlir::Pass::Statistic& callsInlined,
+                   mlir::Pass::Statistic& callsitesTooExpensive);
+
   void pruneEgeHistory() {
     llvm::BitVector dead(m_edgeHistories.size(), true);
     m_module->walk([&](mlir::Operation* op) {
@@ -337,13 +367,23 @@ public:
   Inliner(mlir::ModuleOp moduleOp, std::uint16_t threshold,
           std::uint16_t cyclePenalty, mlir::AnalysisManager analysisManager)
       : m_module(moduleOp), m_threshold(threshold),
-        m_cyclePenalty(cyclePenalty), m_analysisManager(analysisManager) {}
+        m_cyclePenalty(cyclePenalty), m_analysisManager(analysisManager),
+        m_inlineCost(moduleOp->getContext()) {}
 
   /// Performs one iteration of inlining on the module.
-  /// Returns true if at least one callsite was inlined.
-  bool performInlining(mlir::Pass::Statistic& callsInlined,
-                       mlir::Pass::Statistic& directRecursionsDiscarded,
-                       mlir::Pass::Statistic& callsitesTooExpensive);
+  /// Callsites are inlined in post order of the call graph, one SCC at a time,
+  /// making callers see the callees after inlining has been performed within
+  /// them. If 'simplify' is non-null, it is called on every operation changed
+  /// within an SCC prior to processing its callers.
+  /// Returns the closest isolated-from-above operations, usually functions, of
+  /// all callsites that were inlined. These are the only operations changed by
+  /// the iteration. Returns failure if 'simplify' failed.
+  mlir::FailureOr<llvm::SetVector<mlir::Operation*>>
+  performInlining(llvm::function_ref<mlir::LogicalResult(mlir::Operation*)>
+                      simplify,
+                  mlir::Pass::Statistic& callsInlined,
+                  mlir::Pass::Statistic& directRecursionsDiscarded,
+                  mlir::Pass::Statistic& callsitesTooExpensive);
 };
 
 mlir::Operation* getNextClosestIsolatedFromAbove(mlir::Operation* op) {
@@ -554,8 +594,17 @@ Inliner::grade(mlir::CallOpInterface call, mlir::CallableOpInterface callee,
   if (threshold < 0)
     return std::nullopt;
 
-  return gradeFromKnownConstants(std::move(knownConstants), callee, threshold,
-                                 collection);
+  // Inlining removes the call itself. Its cost is therefore subtracted from the
+  // cost of the body, allowing small callees to be inlined for free.
+  auto callCost = static_cast<std::int32_t>(m_inlineCost.getCostOf(call));
+  threshold = std::min<std::int32_t>(threshold + callCost,
+                                     std::numeric_limits<std::uint16_t>::max());
+
+  std::optional<GradeResult> result = gradeFromKnownConstants(
+      std::move(knownConstants), callee, threshold, collection);
+  if (result)
+    result->cost -= std::min<std::int32_t>(result->cost, callCost);
+  return result;
 }
 
 // Formatting function for LLVM_DEBUG output.
@@ -582,57 +631,13 @@ formatCallerForDebug(mlir::CallOpInterface callOpInterface) {
       callOpInterface->getParentOfType<mlir::CallableOpInterface>());
 }
 
-bool Inliner::performInlining(mlir::Pass::Statistic& callsInlined,
-                              mlir::Pass::Statistic& directRecursionsDiscarded,
-                              mlir::Pass::Statistic& callsitesTooExpensive) {
-  pruneEgeHistory();
-
-  mlir::SymbolTableCollection collection;
-
-  auto handleCallOp = [&](mlir::CallOpInterface call,
-                          mlir::CallableOpInterface callable) {
-    // A callable without a callable region can't be inlined as it has no body.
-    // This is the case for function declarations for example.
-    if (!callable.getCallableRegion())
-      return;
-
-    std::optional<GradeResult> grading = grade(call, callable, collection);
-    if (!grading) {
-      // TODO: Should these call-sites be added to the caller list tracked by
-      // the queue anyways? That would allow
-      //  these callsites to be reevaluated after inlining changes have
-      //  happened. At the same time, inlining operations only worsen the grade
-      //  99% of the time, and improvements are usually only visible after the
-      //  interleaved simplification passes have run, in which case all
-      //  call-sites are regraded anyways.
-      callsitesTooExpensive++;
-      return;
-    }
-
-    // If this is a directly recursive callsite and a recursive callsite remains
-    // after inlining, don't inline. Recursive functions must be handled
-    // specially, else-way they easily lead to exponential code explosion.
-    if (callable->isAncestor(call) &&
-        llvm::is_contained(llvm::make_second_range(grading->reachableCallsites),
-                           callable)) {
-      directRecursionsDiscarded++;
-      return;
-    }
-
-    m_queue.emplace(call, callable, grading->cost,
-                    std::move(grading->reachableCallsites));
-  };
-
-  m_module.walk([&](mlir::CallOpInterface callOpInterface) {
-    mlir::CallableOpInterface callable =
-        deduceCallableFromCall(callOpInterface, collection);
-    if (!callable)
-      return;
-
-    handleCallOp(callOpInterface, callable);
-  });
-
-  bool changed = false;
+void Inliner::inlineQueue(
+    llvm::SetVector<mlir::Operation*>& changed,
+    mlir::SymbolTableCollection& collection,
+    llvm::function_ref<void(mlir::CallOpInterface, mlir::CallableOpInterface)>
+        handleCallOp,
+    mlir::Pass::Statistic& callsInlined,
+    mlir::Pass::Statistic& callsitesTooExpensive) {
   while (const CallSite* callSite = m_queue.pop()) {
     LLVM_DEBUG({
       llvm::dbgs() << "Inlining " << formatCalleeForDebug(callSite->getCallee())
@@ -641,7 +646,6 @@ bool Inliner::performInlining(mlir::Pass::Statistic& callsInlined,
     });
 
     callsInlined++;
-    changed = true;
 
     mlir::CallableOpInterface callerCallable;
     for (mlir::Operation* curr = callSite->getCall(); !callerCallable && curr;
@@ -652,6 +656,7 @@ bool Inliner::performInlining(mlir::Pass::Statistic& callsInlined,
 
     mlir::Operation* closestIsolatedFromAbove =
         getNextClosestIsolatedFromAbove(callSite->getCall());
+    changed.insert(closestIsolatedFromAbove);
     mlir::IRMapping mapping =
         Py::inlineCall(callSite->getCall(), callSite->getCallee());
 
@@ -700,6 +705,120 @@ bool Inliner::performInlining(mlir::Pass::Statistic& callsInlined,
       handleCallOp(newCall, callable);
     }
   }
+  // Every callsite has been popped and is therefore marked as erased.
+  m_queue.clear();
+}
+
+mlir::FailureOr<llvm::SetVector<mlir::Operation*>> Inliner::performInlining(
+    llvm::function_ref<mlir::LogicalResult(mlir::Operation*)> simplify,
+    mlir::Pass::Statistic& callsInlined,
+    mlir::Pass::Statistic& directRecursionsDiscarded,
+    mlir::Pass::Statistic& callsitesTooExpensive) {
+  pruneEgeHistory();
+
+  mlir::SymbolTableCollection collection;
+
+  auto handleCallOp = [&](mlir::CallOpInterface call,
+                          mlir::CallableOpInterface callable) {
+    // A callable without a callable region can't be inlined as it has no body.
+    // This is the case for function declarations for example.
+    if (!callable.getCallableRegion())
+      return;
+
+    std::optional<GradeResult> grading = grade(call, callable, collection);
+    if (!grading) {
+      // TODO: Should these call-sites be added to the caller list tracked by
+      // the queue anyways? That would allow
+      //  these callsites to be reevaluated after inlining changes have
+      //  happened. At the same time, inlining operations only worsen the grade
+      //  99% of the time, and improvements are usually only visible after the
+      //  interleaved simplification passes have run, in which case all
+      //  call-sites are regraded anyways.
+      callsitesTooExpensive++;
+      return;
+    }
+
+    // If this is a directly recursive callsite and a recursive callsite remains
+    // after inlining, don't inline. Recursive functions must be handled
+    // specially, else-way they easily lead to exponential code explosion.
+    if (callable->isAncestor(call) &&
+        llvm::is_contained(llvm::make_second_range(grading->reachableCallsites),
+                           callable)) {
+      directRecursionsDiscarded++;
+      return;
+    }
+
+    m_queue.emplace(call, callable, grading->cost,
+                    std::move(grading->reachableCallsites));
+  };
+
+  // The call graph only contains edges of direct calls. Indirect calls are
+  // still inlined if their callee can be deduced, but do not influence the
+  // order of SCCs.
+  mlir::CallGraph callGraph(m_module);
+  llvm::SetVector<mlir::Operation*> changed;
+  for (auto iter = llvm::scc_begin(&std::as_const(callGraph)); !iter.isAtEnd();
+       ++iter) {
+    for (const mlir::CallGraphNode* node : *iter) {
+      if (node->isExternal())
+        continue;
+
+      mlir::Region* region = node->getCallableRegion();
+      region->walk([&](mlir::CallOpInterface callOpInterface) {
+        // Callsites within nested callables are handled by their own node.
+        auto parent =
+            callOpInterface->getParentOfType<mlir::CallableOpInterface>();
+        if (!parent || parent.getCallableRegion() != region)
+          return;
+
+        mlir::CallableOpInterface callable =
+            deduceCallableFromCall(callOpInterface, collection);
+        if (!callable)
+          return;
+
+        handleCallOp(callOpInterface, callable);
+      });
+    }
+
+    llvm::SetVector<mlir::Operation*> changedInSCC;
+    inlineQueue(changedInSCC, collection, handleCallOp, callsInlined,
+                callsitesTooExpensive);
+    if (simplify)
+      for (mlir::Operation* op : changedInSCC)
+        if (mlir::failed(simplify(op)))
+          return mlir::failure();
+
+    changed.insert(changedInSCC.begin(), changedInSCC.end());
+  }
+
+  // Callsites within a callable, but outside of its callable region, are not
+  // part of any node of the call graph. These are handled after all SCCs.
+  // Callsites outside of any callable can't occur, as all executable code
+  // within a module is part of a function.
+  m_module.walk([&](mlir::CallOpInterface callOpInterface) {
+    auto parent = callOpInterface->getParentOfType<mlir::CallableOpInterface>();
+    PYLIR_ASSERT(parent && "Every callsite must be within a callable");
+    mlir::Region* region = parent.getCallableRegion();
+    if (region && region->isAncestor(callOpInterface->getParentRegion()))
+      return;
+
+    mlir::CallableOpInterface callable =
+        deduceCallableFromCall(callOpInterface, collection);
+    if (!callable)
+      return;
+
+    handleCallOp(callOpInterface, callable);
+  });
+
+  llvm::SetVector<mlir::Operation*> changedOutsideSCCs;
+  inlineQueue(changedOutsideSCCs, collection, handleCallOp, callsInlined,
+              callsitesTooExpensive);
+  if (simplify)
+    for (mlir::Operation* op : changedOutsideSCCs)
+      if (mlir::failed(simplify(op)))
+        return mlir::failure();
+
+  changed.insert(changedOutsideSCCs.begin(), changedOutsideSCCs.end());
   return changed;
 }
 
@@ -714,20 +833,68 @@ void InlinerPass::runOnOperation() {
   Inliner inliner(getOperation(), m_threshold, m_cyclePenalty,
                   getAnalysisManager());
   bool changed = false;
+  // True if 'm_passManager' has run on the module since the last change.
+  bool optimized = true;
   [[maybe_unused]] bool escapedEarly = false;
-  for (std::size_t i = 0; i < m_maxInliningIterations; i++) {
+  for (std::size_t i = 0; i < m_maxInliningIterations;) {
     LLVM_DEBUG({ llvm::dbgs() << "Inlining iteration " << i << '\n'; });
-    if (!inliner.performInlining(m_callsInlined, m_directRecursionsDiscarded,
-                                 m_callsitesTooExpensive)) {
-      m_doneEarly++;
-      escapedEarly = true;
-      break;
+    // With a function pipeline, functions changed by inlining are optimized
+    // right after inlining within their SCC, prior to any of their callers
+    // being graded.
+    auto simplify = [&](mlir::Operation* op) {
+      m_functionsReoptimized++;
+      return runPipeline(*m_functionPassManager, op);
+    };
+    mlir::FailureOr<llvm::SetVector<mlir::Operation*>> changedOps =
+        inliner.performInlining(
+            m_functionPassManager
+                ? llvm::function_ref<mlir::LogicalResult(mlir::Operation*)>(
+                      simplify)
+                : nullptr,
+            m_callsInlined, m_directRecursionsDiscarded,
+            m_callsitesTooExpensive);
+    if (mlir::failed(changedOps)) {
+      signalPassFailure();
+      return;
     }
+    if (changedOps->empty()) {
+      if (optimized) {
+        m_doneEarly++;
+        escapedEarly = true;
+        break;
+      }
 
-    // The optimization pipeline is run over the whole module since it contains
-    // module level passes. If it were just function passes we could only run
-    // optimizations on any functions that changed through inlining.
+      // Inlining has reached a fixpoint with just the function pipeline. The
+      // module level passes in the optimization pipeline may still uncover
+      // new callsites, e.g. by turning loads of globals into constants.
+      m_optimizationRun++;
+      if (mlir::failed(runPipeline(m_passManager, getOperation()))) {
+        signalPassFailure();
+        return;
+      }
+      optimized = true;
+      continue;
+    }
     changed = true;
+    i++;
+
+    // Without a function pipeline, the optimization pipeline is run over the
+    // whole module since it contains module level passes. Otherwise, the
+    // functions changed through inlining have already been optimized within
+    // 'performInlining'.
+    if (!m_functionPassManager) {
+      m_optimizationRun++;
+      if (mlir::failed(runPipeline(m_passManager, getOperation()))) {
+        signalPassFailure();
+        return;
+      }
+      continue;
+    }
+
+    optimized = false;
+  }
+
+  if (!optimized) {
     m_optimizationRun++;
     if (mlir::failed(runPipeline(m_passManager, getOperation()))) {
       signalPassFailure();
@@ -747,7 +914,10 @@ void InlinerPass::runOnOperation() {
   getOperation()->walk(
       [&](mlir::Operation* op) { op->removeAttr("py.edge_id"); });
 
-  if (changed)
+  // Analyses were invalidated by the pipelines run within this pass. Inlining
+  // only invalidated the analyses of the changed functions, but not the ones
+  // of the module.
+  if (!changed)
     markAllAnalysesPreserved();
 }
 } // namespace
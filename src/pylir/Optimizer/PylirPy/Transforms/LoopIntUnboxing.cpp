@@ -0,0 +1,508 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/IRMapping.h>
+#include <mlir/Interfaces/ControlFlowInterfaces.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+#include <mlir/Pass/Pass.h>
+
+#include <llvm/ADT/SetVector.h>
+
+#include <pylir/Interfaces/Builtins.hpp>
+#include <pylir/Optimizer/Analysis/LoopInfo.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyAttributes.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+#include <pylir/Optimizer/PylirPy/IR/Value.hpp>
+
+#include "Passes.hpp"
+
+namespace pylir::Py {
+#define GEN_PASS_DEF_LOOPINTUNBOXINGPASS
+#include "pylir/Optimizer/PylirPy/Transforms/Passes.h.inc"
+} // namespace pylir::Py
+
+using namespace mlir;
+using namespace pylir;
+using namespace pylir::Py;
+
+namespace {
+
+/// Rewrites integer values carried around innermost loops to 'index' values
+/// using 'arith' operations instead of 'py.int_add' and 'py.int_cmp'.
+///
+/// The loop is versioned: A fast copy of the loop operates on unboxed values,
+/// while the original loop is kept as slow path. Entering the fast loop
+/// requires all integers flowing into it to be representable as 'index'.
+/// Additions check for signed overflow and branch to the header of the slow
+/// loop with the boxed values of the current iteration if it occurs. This
+/// restarts the iteration in the slow loop, which is only correct as the loop
+/// is required to not have any side effects besides reading memory. Values
+/// used after the loop are boxed on exit.
+class LoopIntUnboxingPass
+    : public pylir::Py::impl::LoopIntUnboxingPassBase<LoopIntUnboxingPass> {
+protected:
+  void runOnOperation() override;
+
+private:
+  /// Versions 'loop' if it has any integers that can be unboxed. Returns true
+  /// if the IR was changed.
+  bool unboxLoop(Loop* loop, LoopInfo& loopInfo);
+
+public:
+  using Base::Base;
+};
+
+bool isInt(Value value) {
+  OpFoldResult type = getTypeOf(value);
+  auto globalValue = dyn_cast_or_null<GlobalValueAttr>(
+      type ? type.dyn_cast<Attribute>() : nullptr);
+  return globalValue && globalValue.getName() == Builtins::Int.name;
+}
+
+/// Returns true if 'op' does not have any memory effects besides reading.
+bool onlyReadsMemory(Operation* op) {
+  if (isMemoryEffectFree(op))
+    return true;
+
+  auto memoryEffectOp = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!memoryEffectOp)
+    return false;
+
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  memoryEffectOp.getEffects(effects);
+  return llvm::all_of(effects, [](const MemoryEffects::EffectInstance& effect) {
+    return isa<MemoryEffects::Read>(effect.getEffect());
+  });
+}
+
+arith::CmpIPredicate toCmpIPredicate(IntCmpKind kind) {
+  switch (kind) {
+  case IntCmpKind::eq: return arith::CmpIPredicate::eq;
+  case IntCmpKind::ne: return arith::CmpIPredicate::ne;
+  case IntCmpKind::lt: return arith::CmpIPredicate::slt;
+  case IntCmpKind::le: return arith::CmpIPredicate::sle;
+  case IntCmpKind::gt: return arith::CmpIPredicate::sgt;
+  case IntCmpKind::ge: return arith::CmpIPredicate::sge;
+  }
+  llvm_unreachable("unknown int comparison");
+}
+
+bool LoopIntUnboxingPass::unboxLoop(Loop* loop, LoopInfo& loopInfo) {
+  Block* header = loop->getHeader();
+  // Only innermost loops are versioned.
+  if (llvm::any_of(loop->getBlocks(), [&](Block* block) {
+        return loopInfo.getLoopFor(block) != loop;
+      }))
+    return false;
+
+  // Values entering the loop are checked on the single edge entering it.
+  std::optional<unsigned> entrySuccessor;
+  BranchOpInterface entryBranch;
+  for (auto iter = header->pred_begin(); iter != header->pred_end(); iter++) {
+    if (loop->contains(*iter))
+      continue;
+    if (entryBranch)
+      return false;
+
+    entryBranch = dyn_cast<BranchOpInterface>((*iter)->getTerminator());
+    if (!entryBranch)
+      return false;
+    entrySuccessor = iter.getSuccessorIndex();
+  }
+  if (!entryBranch)
+    return false;
+
+  // Values used after the loop are merged in the single block the loop exits
+  // to.
+  Block* exitBlock = nullptr;
+  for (Block* block : loop->getBlocks()) {
+    if (!llvm::all_of(*block, onlyReadsMemory))
+      return false;
+
+    Operation* terminator = block->getTerminator();
+    auto branchOp = dyn_cast<BranchOpInterface>(terminator);
+    if (!branchOp)
+      return false;
+
+    for (auto [index, successor] :
+         llvm::enumerate(terminator->getSuccessors())) {
+      if (loop->contains(successor))
+        continue;
+      if (exitBlock && exitBlock != successor)
+        return false;
+      if (branchOp.getSuccessorOperands(index).getProducedOperandCount() != 0)
+        return false;
+      exitBlock = successor;
+    }
+  }
+  if (exitBlock && llvm::any_of(exitBlock->getPredecessors(), [&](Block* pred) {
+        return !loop->contains(pred);
+      }))
+    return false;
+
+  auto getIncoming = [](Block::pred_iterator iter, BlockArgument arg) {
+    return cast<BranchOpInterface>((*iter)->getTerminator())
+        .getSuccessorOperands(iter.getSuccessorIndex())[arg.getArgNumber()];
+  };
+
+  // Determine the values that can be unboxed, starting optimistically with all
+  // loop-carried values and additions and removing values until a fixpoint is
+  // reached.
+  llvm::SetVector<Value> unboxed;
+  for (BlockArgument arg : header->getArguments())
+    if (isa<DynamicType>(arg.getType()))
+      unboxed.insert(arg);
+  for (Block* block : loop->getBlocks())
+    for (auto addOp : block->getOps<IntAddOp>())
+      unboxed.insert(addOp);
+
+  auto isInvariantInt = [&](Value value) {
+    return !loop->contains(value.getParentBlock()) && isInt(value);
+  };
+  auto canBeUnboxed = [&](Value value) {
+    return unboxed.contains(value) || isInvariantInt(value);
+  };
+  auto isValid = [&](Value value) {
+    if (auto arg = dyn_cast<BlockArgument>(value)) {
+      for (auto iter = header->pred_begin(); iter != header->pred_end();
+           iter++) {
+        Value incoming = getIncoming(iter, arg);
+        if (!incoming)
+          return false;
+        if (loop->contains(*iter) ? !canBeUnboxed(incoming) : !isInt(incoming))
+          return false;
+      }
+    } else {
+      auto addOp = value.getDefiningOp<IntAddOp>();
+      if (!canBeUnboxed(addOp.getLhs()) || !canBeUnboxed(addOp.getRhs()))
+        return false;
+    }
+
+    for (OpOperand& use : value.getUses()) {
+      Operation* user = use.getOwner();
+      if (!loop->contains(user->getBlock()))
+        continue;
+
+      if (auto addOp = dyn_cast<IntAddOp>(user);
+          addOp && unboxed.contains(addOp))
+        continue;
+
+      if (auto cmpOp = dyn_cast<IntCmpOp>(user);
+          cmpOp && canBeUnboxed(cmpOp.getLhs()) &&
+          canBeUnboxed(cmpOp.getRhs()))
+        continue;
+
+      if (auto branchOp = dyn_cast<BranchOpInterface>(user)) {
+        std::optional<BlockArgument> blockArg =
+            branchOp.getSuccessorBlockArgument(use.getOperandNumber());
+        if (blockArg && blockArg->getOwner() == header &&
+            unboxed.contains(*blockArg))
+          continue;
+        if (blockArg && blockArg->getOwner() == exitBlock)
+          continue;
+      }
+      return false;
+    }
+    return true;
+  };
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (Value value : llvm::to_vector(unboxed)) {
+      if (isValid(value))
+        continue;
+      unboxed.remove(value);
+      changed = true;
+    }
+  }
+
+  SmallVector<BlockArgument> unboxedArgs;
+  for (BlockArgument arg : header->getArguments())
+    if (unboxed.contains(arg))
+      unboxedArgs.push_back(arg);
+  if (unboxedArgs.empty() || llvm::none_of(unboxed, [](Value value) {
+        return value.getDefiningOp<IntAddOp>();
+      }))
+    return false;
+
+  // Values defined within the loop that are used after it.
+  llvm::SetVector<Value> liveOut;
+  for (Block* block : loop->getBlocks()) {
+    auto addIfLiveOut = [&](Value value) {
+      if (llvm::any_of(value.getUsers(), [&](Operation* user) {
+            return !loop->contains(user->getBlock());
+          }))
+        liveOut.insert(value);
+    };
+    llvm::for_each(block->getArguments(), addIfLiveOut);
+    for (Operation& op : *block)
+      llvm::for_each(op.getResults(), addIfLiveOut);
+  }
+
+  // Create the fast version of the loop as a copy of the original.
+  Region& region = *header->getParent();
+  IRMapping mapping;
+  SmallVector<Block*> fastBlocks;
+  for (Block* block : loop->getBlocks()) {
+    auto* clone = new Block;
+    region.push_back(clone);
+    fastBlocks.push_back(clone);
+    mapping.map(block, clone);
+    for (BlockArgument arg : block->getArguments())
+      mapping.map(arg, clone->addArgument(arg.getType(), arg.getLoc()));
+  }
+  for (auto [block, clone] : llvm::zip(loop->getBlocks(), fastBlocks)) {
+    auto builder = OpBuilder::atBlockEnd(clone);
+    for (Operation& op : *block)
+      builder.clone(op, mapping);
+  }
+  // Operands defined in blocks cloned after their use have to be remapped.
+  for (Block* block : fastBlocks)
+    for (Operation& op : *block)
+      for (OpOperand& operand : op.getOpOperands())
+        if (Value value = mapping.lookupOrNull(operand.get()))
+          operand.set(value);
+
+  Block* fastHeader = mapping.lookup(header);
+  llvm::DenseSet<Value> fastUnboxed;
+  for (Value value : unboxed)
+    fastUnboxed.insert(mapping.lookup(value));
+
+  // Block checking that all integers entering the fast loop are representable
+  // as index.
+  auto* entry = new Block;
+  entry->insertBefore(fastHeader);
+  auto entryBuilder = OpBuilder::atBlockEnd(entry);
+  SmallVector<Value> entryOperands =
+      llvm::to_vector(entryBranch.getSuccessorOperands(*entrySuccessor)
+                          .getForwardedOperands());
+  entryBranch->setSuccessor(entry, *entrySuccessor);
+  entryBranch.getSuccessorOperands(*entrySuccessor)
+      .erase(0, entryOperands.size());
+
+  llvm::DenseMap<Value, Value> unboxedValues;
+  SmallVector<Value> validFlags;
+  auto unboxInvariant = [&](Value value) -> Value {
+    Value& result = unboxedValues[value];
+    if (!result) {
+      auto tryToIndex =
+          entryBuilder.create<IntTryToIndexOp>(value.getLoc(), value);
+      validFlags.push_back(tryToIndex.getValid());
+      result = tryToIndex.getResult();
+    }
+    return result;
+  };
+
+  for (BlockArgument arg : unboxedArgs)
+    unboxedValues[mapping.lookup(arg)] =
+        fastHeader->addArgument(entryBuilder.getIndexType(), arg.getLoc());
+
+  // Fast additions with their overflow flags.
+  SmallVector<std::pair<IntAddOp, Value>> fastAdditions;
+  std::function<Value(Value)> getUnboxed = [&](Value value) -> Value {
+    if (Value result = unboxedValues.lookup(value))
+      return result;
+
+    if (!fastUnboxed.contains(value))
+      return unboxInvariant(value);
+
+    auto addOp = value.getDefiningOp<IntAddOp>();
+    Value lhs = getUnboxed(addOp.getLhs());
+    Value rhs = getUnboxed(addOp.getRhs());
+    OpBuilder builder(addOp);
+    Value sum = builder.create<arith::AddIOp>(addOp.getLoc(), lhs, rhs);
+    // Signed overflow occurred if the sign of the sum differs from the signs
+    // of both operands.
+    Value overflowBits = builder.create<arith::AndIOp>(
+        addOp.getLoc(), builder.create<arith::XOrIOp>(addOp.getLoc(), lhs, sum),
+        builder.create<arith::XOrIOp>(addOp.getLoc(), rhs, sum));
+    Value overflow = builder.create<arith::CmpIOp>(
+        addOp.getLoc(), arith::CmpIPredicate::slt, overflowBits,
+        builder.create<arith::ConstantIndexOp>(addOp.getLoc(), 0));
+    fastAdditions.emplace_back(addOp, overflow);
+    m_valuesUnboxed++;
+    return unboxedValues[value] = sum;
+  };
+
+  for (Value value : unboxed)
+    if (value.getDefiningOp<IntAddOp>())
+      getUnboxed(mapping.lookup(value));
+
+  // Comparisons of unboxed values only have other unboxed or invariant integers
+  // as operands, as ensured when computing 'unboxed'.
+  for (Block* block : loop->getBlocks()) {
+    for (auto cmpOp : block->getOps<IntCmpOp>()) {
+      if (!unboxed.contains(cmpOp.getLhs()) &&
+          !unboxed.contains(cmpOp.getRhs()))
+        continue;
+
+      auto fastCmpOp = cast<IntCmpOp>(mapping.lookup(cmpOp.getResult())
+                                          .getDefiningOp());
+      OpBuilder builder(fastCmpOp);
+      Value lhs = getUnboxed(fastCmpOp.getLhs());
+      Value rhs = getUnboxed(fastCmpOp.getRhs());
+      Value result = builder.create<arith::CmpIOp>(
+          cmpOp.getLoc(), toCmpIPredicate(cmpOp.getPred()), lhs, rhs);
+      fastCmpOp.replaceAllUsesWith(result);
+      fastCmpOp.erase();
+      mapping.map(cmpOp.getResult(), result);
+    }
+  }
+
+  // Back edges pass the unboxed values instead.
+  for (Block* block : fastBlocks) {
+    auto branchOp = cast<BranchOpInterface>(block->getTerminator());
+    for (unsigned i = 0; i < branchOp->getNumSuccessors(); i++) {
+      if (branchOp->getSuccessor(i) != fastHeader)
+        continue;
+
+      SuccessorOperands successorOperands = branchOp.getSuccessorOperands(i);
+      SmallVector<Value> newOperands;
+      for (BlockArgument arg : unboxedArgs)
+        newOperands.push_back(
+            getUnboxed(successorOperands[arg.getArgNumber()]));
+      for (BlockArgument arg : llvm::reverse(unboxedArgs))
+        successorOperands.erase(arg.getArgNumber());
+      successorOperands.append(newOperands);
+    }
+  }
+
+  // Restarts the current iteration in the slow loop.
+  auto* deopt = new Block;
+  region.push_back(deopt);
+  auto deoptBuilder = OpBuilder::atBlockEnd(deopt);
+  SmallVector<Value> deoptOperands;
+  for (BlockArgument arg : header->getArguments()) {
+    Value fastArg = mapping.lookup(arg);
+    if (!fastUnboxed.contains(fastArg)) {
+      deoptOperands.push_back(fastArg);
+      continue;
+    }
+    deoptOperands.push_back(deoptBuilder.create<IntFromSignedOp>(
+        arg.getLoc(), unboxedValues.lookup(fastArg)));
+  }
+  deoptBuilder.create<cf::BranchOp>(header->front().getLoc(), header,
+                                    deoptOperands);
+
+  for (auto [addOp, overflow] : fastAdditions) {
+    Block* before = addOp->getBlock();
+    Block* after = before->splitBlock(addOp);
+    auto builder = OpBuilder::atBlockEnd(before);
+    builder.create<cf::CondBranchOp>(addOp.getLoc(), overflow, deopt, after);
+  }
+
+  // Merge the values used after the loop in the exit block, boxing values
+  // coming from the fast loop on the exiting edges.
+  if (exitBlock) {
+    SmallVector<Value> liveOutArgs;
+    for (Value value : liveOut) {
+      BlockArgument arg = exitBlock->addArgument(value.getType(), value.getLoc());
+      value.replaceUsesWithIf(arg, [&](OpOperand& use) {
+        return !loop->contains(use.getOwner()->getBlock());
+      });
+      liveOutArgs.push_back(arg);
+    }
+
+    auto box = [&](OpBuilder& builder, Value value) -> Value {
+      if (!fastUnboxed.contains(value))
+        return value;
+      return builder.create<IntFromSignedOp>(value.getLoc(),
+                                             getUnboxed(value));
+    };
+
+    for (Block* block : loop->getBlocks()) {
+      auto branchOp = cast<BranchOpInterface>(block->getTerminator());
+      for (unsigned i = 0; i < branchOp->getNumSuccessors(); i++)
+        if (branchOp->getSuccessor(i) == exitBlock)
+          branchOp.getSuccessorOperands(i).append(liveOut.getArrayRef());
+    }
+
+    // Fast blocks were split above, hence the exiting blocks of the fast loop
+    // have to be looked up anew.
+    llvm::SetVector<Block*> fastExiting;
+    for (Block* pred : exitBlock->getPredecessors())
+      if (!loop->contains(pred))
+        fastExiting.insert(pred);
+
+    for (Block* block : fastExiting) {
+      auto branchOp = cast<BranchOpInterface>(block->getTerminator());
+      for (unsigned i = 0; i < branchOp->getNumSuccessors(); i++) {
+        if (branchOp->getSuccessor(i) != exitBlock)
+          continue;
+
+        SuccessorOperands successorOperands = branchOp.getSuccessorOperands(i);
+        SmallVector<Value> operands =
+            llvm::to_vector(successorOperands.getForwardedOperands());
+        successorOperands.erase(0, operands.size());
+
+        auto* exitEdge = new Block;
+        exitEdge->insertBefore(exitBlock);
+        branchOp->setSuccessor(exitEdge, i);
+        auto builder = OpBuilder::atBlockEnd(exitEdge);
+        SmallVector<Value> exitOperands;
+        for (Value operand : operands)
+          exitOperands.push_back(box(builder, operand));
+        for (Value value : liveOut)
+          exitOperands.push_back(box(builder, mapping.lookup(value)));
+        builder.create<cf::BranchOp>(exitBlock->front().getLoc(), exitBlock,
+                                     exitOperands);
+      }
+    }
+  }
+
+  // Enter the fast loop if all integers are representable as index.
+  SmallVector<Value> fastEntryOperands;
+  for (auto [arg, operand] : llvm::zip(header->getArguments(), entryOperands))
+    if (!unboxed.contains(arg))
+      fastEntryOperands.push_back(operand);
+  for (BlockArgument arg : unboxedArgs)
+    fastEntryOperands.push_back(
+        unboxInvariant(entryOperands[arg.getArgNumber()]));
+
+  Value allValid = validFlags.front();
+  for (Value valid : llvm::drop_begin(validFlags))
+    allValid = entryBuilder.create<arith::AndIOp>(valid.getLoc(), allValid,
+                                                  valid);
+  entryBuilder.create<cf::CondBranchOp>(header->front().getLoc(), allValid,
+                                        fastHeader, fastEntryOperands, header,
+                                        entryOperands);
+
+  // The boxed versions of the unboxed values are now unused within the fast
+  // loop.
+  for (auto [addOp, overflow] : llvm::reverse(fastAdditions))
+    addOp.erase();
+  fastHeader->eraseArguments(
+      [&](BlockArgument arg) { return fastUnboxed.contains(arg); });
+
+  m_loopsVersioned++;
+  return true;
+}
+
+void LoopIntUnboxingPass::runOnOperation() {
+  if (getOperation()->getNumRegions() == 0 ||
+      getOperation()->getRegion(0).empty()) {
+    markAllAnalysesPreserved();
+    return;
+  }
+
+  auto& loopInfo = getAnalysis<LoopInfo>();
+  // Collected upfront as versioning adds blocks to the region.
+  SmallVector<Loop*> loops;
+  for (Block& block : getOperation()->getRegion(0))
+    if (Loop* loop = loopInfo.getLoopFor(&block);
+        loop && loop->getHeader() == &block)
+      loops.push_back(loop);
+
+  bool changed = false;
+  for (Loop* loop : loops)
+    changed |= unboxLoop(loop, loopInfo);
+
+  if (!changed)
+    markAllAnalysesPreserved();
+}
+
+} // namespace
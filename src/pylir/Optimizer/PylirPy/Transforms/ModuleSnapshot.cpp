@@ -0,0 +1,296 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
+#include <mlir/IR/Matchers.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+#include <mlir/Pass/Pass.h>
+
+#include <llvm/ADT/StringSet.h>
+
+#include <pylir/Optimizer/PylirPy/IR/PylirPyAttributes.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyDialect.hpp>
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
+
+#include "Passes.hpp"
+
+namespace pylir::Py {
+#define GEN_PASS_DEF_MODULESNAPSHOTPASS
+#include "pylir/Optimizer/PylirPy/Transforms/Passes.h.inc"
+} // namespace pylir::Py
+
+using namespace mlir;
+using namespace pylir;
+using namespace pylir::Py;
+
+namespace {
+
+/// Executes the straight-line prefix of module initializers at compile time by
+/// folding writes of constants into module dictionaries and private globals
+/// into their initializers. These then become part of the static data of the
+/// executable instead of being recomputed on every startup.
+class ModuleSnapshotPass
+    : public pylir::Py::impl::ModuleSnapshotPassBase<ModuleSnapshotPass> {
+protected:
+  void runOnOperation() override;
+
+private:
+  /// Returns the first operation of the body of the module initializer
+  /// 'funcOp' or null if 'funcOp' is not a module initializer.
+  /// The body of a module initializer is executed exactly once. For any module
+  /// but the main module this is only true after the initialization guard.
+  Operation* getInitBodyStart(FuncOp funcOp, SymbolTable& symbolTable);
+
+  /// Attempts to fold 'op' within the straight-line prefix of a module
+  /// initializer into static data. Returns true if 'op' was erased.
+  bool foldIntoSnapshot(Operation* op, SymbolTable& symbolTable);
+
+  /// Replaces 'makeFuncOp' with a reference to a new global value initialized
+  /// with the function object. Returns the new global value or null if not
+  /// possible.
+  GlobalValueAttr materializeFunction(MakeFuncOp makeFuncOp);
+
+  /// Returns 'value' as an attribute that may be used as initial value of a
+  /// dictionary entry or global. Returns null if not possible.
+  Attribute getSnapshotValue(Value value);
+
+  /// Returns true if 'op' is a call to the initializer of another module that
+  /// can never call back into the module initializer 'initializer'. Such calls
+  /// are unable to observe the state of the module being initialized.
+  bool isIndependentInitializerCall(Operation* op, FuncOp initializer,
+                                    SymbolTable& symbolTable);
+
+  /// Returns the names of all symbols that may be referenced when executing
+  /// 'funcOp'.
+  const llvm::DenseSet<StringAttr>& getReachableSymbols(FuncOp funcOp,
+                                                        SymbolTable& symbolTable);
+
+  llvm::StringSet<> m_usedNames;
+  llvm::DenseMap<FuncOp, llvm::DenseSet<StringAttr>> m_reachableSymbols;
+
+public:
+  using Base::Base;
+};
+
+Operation* ModuleSnapshotPass::getInitBodyStart(FuncOp funcOp,
+                                                SymbolTable& symbolTable) {
+  if (funcOp.isExternal())
+    return nullptr;
+
+  // The main module is only ever initialized once by the entry point.
+  if (funcOp.getName() == "__init__")
+    return &funcOp.getBody().front().front();
+
+  // Any other module initializer is guarded by a global it sets to 1 the first
+  // time it is executed. See the lowering of 'pyHIR.init'.
+  if (!funcOp.getName().ends_with(".__init__"))
+    return nullptr;
+
+  auto guard = symbolTable.lookup<GlobalOp>(
+      (funcOp.getName() + "$initialized").str());
+  if (!guard)
+    return nullptr;
+
+  StoreOp guardStore;
+  funcOp->walk([&](StoreOp storeOp) {
+    if (storeOp.getGlobalAttr().getAttr() != guard.getSymNameAttr())
+      return WalkResult::advance();
+
+    guardStore = storeOp;
+    return WalkResult::interrupt();
+  });
+  if (!guardStore)
+    return nullptr;
+
+  return guardStore->getNextNode();
+}
+
+const llvm::DenseSet<StringAttr>&
+ModuleSnapshotPass::getReachableSymbols(FuncOp funcOp,
+                                        SymbolTable& symbolTable) {
+  auto [iter, inserted] = m_reachableSymbols.try_emplace(funcOp);
+  if (!inserted)
+    return iter->second;
+
+  llvm::DenseSet<StringAttr>& reachable = iter->second;
+  SmallVector<Operation*> opWorklist{funcOp};
+  SmallVector<Attribute> attrWorklist;
+  llvm::DenseSet<GlobalValueAttr> seenGlobalValues;
+
+  // Functions may not only be referenced by operations but also by the
+  // initializers of global values, which the walker does not descend into.
+  AttrTypeWalker walker;
+  walker.addWalk([&](SymbolRefAttr ref) {
+    if (!reachable.insert(ref.getRootReference()).second)
+      return;
+    if (Operation* symbol = symbolTable.lookup(ref.getRootReference()))
+      opWorklist.push_back(symbol);
+  });
+  walker.addWalk([&](GlobalValueAttr globalValueAttr) {
+    if (!seenGlobalValues.insert(globalValueAttr).second)
+      return;
+    if (globalValueAttr.getInitializer())
+      attrWorklist.push_back(globalValueAttr.getInitializer());
+  });
+
+  while (!opWorklist.empty() || !attrWorklist.empty()) {
+    if (!attrWorklist.empty()) {
+      walker.walk(attrWorklist.pop_back_val());
+      continue;
+    }
+    opWorklist.pop_back_val()->walk(
+        [&](Operation* op) { walker.walk(op->getAttrDictionary()); });
+  }
+  return reachable;
+}
+
+bool ModuleSnapshotPass::isIndependentInitializerCall(
+    Operation* op, FuncOp initializer, SymbolTable& symbolTable) {
+  auto callOp = dyn_cast<CallOp>(op);
+  if (!callOp || !callOp.getCallee().ends_with(".__init__"))
+    return false;
+
+  auto callee = symbolTable.lookup<FuncOp>(callOp.getCalleeAttr().getAttr());
+  if (!callee || callee == initializer)
+    return false;
+
+  return !getReachableSymbols(callee, symbolTable)
+              .contains(initializer.getSymNameAttr());
+}
+
+Attribute ModuleSnapshotPass::getSnapshotValue(Value value) {
+  Attribute attr;
+  if (matchPattern(value, m_Constant(&attr))) {
+    if (isa<GlobalValueAttr, ConcreteObjectAttribute>(attr))
+      return attr;
+    return nullptr;
+  }
+
+  // Function objects created within the prefix can be turned into global
+  // values as the prefix is executed exactly once.
+  if (auto makeFuncOp = value.getDefiningOp<MakeFuncOp>())
+    return materializeFunction(makeFuncOp);
+
+  return nullptr;
+}
+
+GlobalValueAttr ModuleSnapshotPass::materializeFunction(MakeFuncOp makeFuncOp) {
+  if (!makeFuncOp.getClosureArgs().empty())
+    return nullptr;
+
+  // Global values are uniqued by name. Find a name that has not yet been used
+  // by this pass or any other global value with an initializer.
+  std::string baseName = (makeFuncOp.getFunction() + "$snapshot").str();
+  std::string name = baseName;
+  GlobalValueAttr globalValue;
+  for (std::size_t counter = 0;; counter++) {
+    if (counter != 0)
+      name = baseName + std::to_string(counter);
+    if (m_usedNames.contains(name))
+      continue;
+
+    globalValue = GlobalValueAttr::get(&getContext(), name);
+    if (!globalValue.getInitializer())
+      break;
+  }
+  m_usedNames.insert(name);
+
+  globalValue.setInitializer(FunctionAttr::get(makeFuncOp.getFunctionAttr()));
+
+  OpBuilder builder(makeFuncOp);
+  auto constant =
+      builder.create<ConstantOp>(makeFuncOp->getLoc(), globalValue);
+  makeFuncOp->replaceAllUsesWith(constant);
+  makeFuncOp->erase();
+  m_functionsMaterialized++;
+  return globalValue;
+}
+
+bool ModuleSnapshotPass::foldIntoSnapshot(Operation* op,
+                                          SymbolTable& symbolTable) {
+  if (auto setItemOp = dyn_cast<DictSetItemOp>(op)) {
+    GlobalValueAttr dict;
+    if (!matchPattern(setItemOp.getDict(), m_Constant(&dict)) ||
+        dict.getConstant())
+      return false;
+
+    auto initializer = dyn_cast_or_null<DictAttr>(dict.getInitializer());
+    if (!initializer)
+      return false;
+
+    // Only string keys are currently supported as their hash can be computed
+    // while emitting the dictionary.
+    StrAttr key;
+    if (!matchPattern(setItemOp.getKey(), m_Constant(&key)))
+      return false;
+
+    Attribute value = getSnapshotValue(setItemOp.getValue());
+    if (!value)
+      return false;
+
+    SmallVector<DictAttr::Entry> entries;
+    for (auto [entryKey, entryValue] : initializer.getKeyValuePairs())
+      entries.emplace_back(cast<EqualsAttrInterface>(entryKey), entryValue);
+    entries.emplace_back(key, value);
+    dict.setInitializer(DictAttr::get(&getContext(), entries));
+    setItemOp->erase();
+    m_dictEntriesFolded++;
+    return true;
+  }
+
+  if (auto storeOp = dyn_cast<StoreOp>(op)) {
+    auto global = symbolTable.lookup<GlobalOp>(storeOp.getGlobal());
+    if (!global || global.isPublic() || !isa<DynamicType>(global.getType()))
+      return false;
+
+    Attribute value = getSnapshotValue(storeOp.getValue());
+    if (!value)
+      return false;
+
+    global.setInitializerAttr(value);
+    storeOp->erase();
+    m_storesFolded++;
+    return true;
+  }
+
+  return false;
+}
+
+void ModuleSnapshotPass::runOnOperation() {
+  m_usedNames.clear();
+  m_reachableSymbols.clear();
+
+  SymbolTable symbolTable(getOperation());
+  bool changed = false;
+  for (auto funcOp :
+       llvm::make_early_inc_range(getOperation().getOps<FuncOp>())) {
+    Operation* current = getInitBodyStart(funcOp, symbolTable);
+    // Walk the straight-line prefix of the initializer. Any operation with side
+    // effects that cannot be folded into the static data of the executable
+    // ends the prefix as it may observe the state of the heap.
+    while (current) {
+      Operation* next = current->getNextNode();
+      if (auto branchOp = dyn_cast<cf::BranchOp>(current)) {
+        Block* successor = branchOp.getDest();
+        if (!successor->getSinglePredecessor())
+          break;
+        next = &successor->front();
+      } else if (foldIntoSnapshot(current, symbolTable)) {
+        changed = true;
+      } else if (!isMemoryEffectFree(current) && !isa<MakeFuncOp>(current) &&
+                 !isIndependentInitializerCall(current, funcOp, symbolTable)) {
+        // 'py.makeFunc' solely creates a new object and can therefore be
+        // skipped. Initializing other modules, most notably 'builtins', can
+        // equally be skipped as long as these cannot observe the module.
+        break;
+      }
+      current = next;
+    }
+  }
+
+  if (!changed)
+    markAllAnalysesPreserved();
+}
+
+} // namespace
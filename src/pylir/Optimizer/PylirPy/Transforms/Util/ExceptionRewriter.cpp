@@ -3,3 +3,47 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include "ExceptionRewriter.hpp"
+
+#include <pylir/Optimizer/Interfaces/CaptureInterface.hpp>
+
+using namespace mlir;
+using namespace pylir::Py;
+
+namespace {
+bool isCaptured(OpOperand& use) {
+  auto capture = dyn_cast<pylir::CaptureInterface>(use.getOwner());
+  return !capture || capture.capturesValue(use.get());
+}
+} // namespace
+
+bool pylir::Py::raisesUnretainedException(RaiseOp raiseOp) {
+  Value exception = raiseOp.getException();
+  if (!exception.getDefiningOp<MakeObjectOp>())
+    return false;
+
+  // Raising is a terminator and only ever executed once per object. Other raise
+  // sites are therefore not an issue.
+  return llvm::all_of(exception.getUses(), [](OpOperand& use) {
+    return isa<RaiseOp>(use.getOwner()) || !isCaptured(use);
+  });
+}
+
+bool pylir::Py::isNonRetainingExceptionHandler(Block* handler) {
+  if (handler->getNumArguments() == 0 || handler->hasNoPredecessors())
+    return false;
+
+  // 'py.raiseEx' branches to the handler directly with an exception object
+  // that may previously have been caught and retained somewhere. Only objects
+  // reaching the handler through unwinding are known to have just been raised.
+  for (Block* predecessor : handler->getPredecessors()) {
+    Operation* terminator = predecessor->getTerminator();
+    auto exceptionHandling = dyn_cast<ExceptionHandlingInterface>(terminator);
+    if (!exceptionHandling || isa<RaiseExOp>(terminator) ||
+        exceptionHandling.getHappyPath() == handler)
+      return false;
+  }
+
+  return llvm::all_of(handler->getArgument(0).getUses(), [](OpOperand& use) {
+    return isa<RaiseOp>(use.getOwner()) || !isCaptured(use);
+  });
+}
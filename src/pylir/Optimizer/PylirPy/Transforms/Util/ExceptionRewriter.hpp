@@ -7,6 +7,7 @@
 #include <mlir/Dialect/ControlFlow/IR/ControlFlowOps.h>
 #include <mlir/IR/PatternMatch.h>
 
+#include <pylir/Optimizer/PylirPy/IR/PylirPyOps.hpp>
 #include <pylir/Optimizer/PylirPy/IR/PylirPyTraits.hpp>
 
 namespace pylir::Py {
@@ -182,4 +183,15 @@ struct OpExRewritePattern : public mlir::OpInterfaceRewritePattern<Interface> {
   matchAndRewrite(Interface op, ExceptionRewriter& rewriter) const = 0;
 };
 
+/// Returns true if the exception object raised by 'raiseOp' is not referenced
+/// by anything but the raised exception itself. This is the case if it was
+/// created within the same function and never captured prior to being raised.
+bool raisesUnretainedException(RaiseOp raiseOp);
+
+/// Returns true if 'handler' is only ever entered through unwinding and never
+/// retains the exception object passed as its first block argument. The
+/// exception object may only be used by operations not capturing it or be
+/// reraised.
+bool isNonRetainingExceptionHandler(mlir::Block* handler);
+
 } // namespace pylir::Py
@@ -0,0 +1,62 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/Dialect.h>
+#include <mlir/Pass/Pass.h>
+#include <mlir/Rewrite/FrozenRewritePatternSet.h>
+#include <mlir/Transforms/GreedyPatternRewriteDriver.h>
+
+#include <memory>
+
+namespace pylir {
+#define GEN_PASS_DEF_CANONICALIZERPASS
+#include "pylir/Optimizer/Transforms/Passes.h.inc"
+} // namespace pylir
+
+using namespace mlir;
+
+namespace {
+/// Equivalent of the upstream canonicalizer, which additionally preserves all
+/// analyses if it did not change the IR. This allows 'pylir-fixpoint' to detect
+/// a fixpoint without fingerprinting the IR.
+class CanonicalizerPass final
+    : public pylir::impl::CanonicalizerPassBase<CanonicalizerPass> {
+  std::shared_ptr<const FrozenRewritePatternSet> m_patterns;
+
+public:
+  using Base::Base;
+
+protected:
+  LogicalResult initialize(MLIRContext* context) override;
+
+  void runOnOperation() override;
+};
+
+} // namespace
+
+LogicalResult CanonicalizerPass::initialize(MLIRContext* context) {
+  RewritePatternSet patterns(context);
+  for (Dialect* dialect : context->getLoadedDialects())
+    dialect->getCanonicalizationPatterns(patterns);
+  for (RegisteredOperationName op : context->getRegisteredOperations())
+    op.getCanonicalizationPatterns(patterns, context);
+
+  m_patterns = std::make_shared<FrozenRewritePatternSet>(std::move(patterns));
+  return success();
+}
+
+void CanonicalizerPass::runOnOperation() {
+  GreedyRewriteConfig config;
+  config.enableRegionSimplification =
+      m_regionSimplification ? GreedySimplifyRegionLevel::Normal
+                             : GreedySimplifyRegionLevel::Disabled;
+
+  bool changed = false;
+  // Not converging within the iteration limit is not an error, matching the
+  // upstream canonicalizer.
+  (void)applyPatternsAndFoldGreedily(getOperation(), *m_patterns, config,
+                                     &changed);
+  if (!changed)
+    markAllAnalysesPreserved();
+}
@@ -0,0 +1,303 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/Dominance.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <pylir/Optimizer/Analysis/MemorySSA.hpp>
+#include <pylir/Optimizer/Interfaces/CaptureInterface.hpp>
+#include <pylir/Optimizer/Interfaces/SROAInterfaces.hpp>
+#include <pylir/Optimizer/PylirPy/Interfaces/OnlyReadsValueInterface.hpp>
+
+#include "Passes.hpp"
+
+namespace pylir {
+#define GEN_PASS_DEF_DEADSTOREELIMINATIONPASS
+#include "pylir/Optimizer/Transforms/Passes.h.inc"
+} // namespace pylir
+
+using namespace mlir;
+
+namespace {
+
+using MemoryLocation = llvm::PointerUnion<Value, SymbolRefAttr>;
+
+/// Removes stores whose written value can never be read.
+///
+/// A store is dead if either every path following it overwrites the exact same
+/// location prior to any possible read, or if it writes to an object allocated
+/// within the function that is neither read nor escapes.
+class DeadStoreEliminationPass
+    : public pylir::impl::DeadStoreEliminationPassBase<
+          DeadStoreEliminationPass> {
+
+  pylir::MemorySSA* m_memorySSA = nullptr;
+  AliasAnalysis* m_aliasAnalysis = nullptr;
+
+  /// Objects allocated within the function that are never read and do not
+  /// escape.
+  llvm::DenseSet<Value> m_unreadObjects;
+
+  /// Returns the single memory def of 'op' if it is a store that may be
+  /// removed. A store must have no results and only write to memory.
+  pylir::MemSSA::MemoryDefOp getStoreDef(Operation* op);
+
+  /// Returns true if 'object' is allocated by an operation, never read and does
+  /// not escape.
+  bool isUnreadObject(Value object);
+
+  /// Returns true if 'lhs' and 'rhs' may refer to the same memory.
+  bool mayAlias(MemoryLocation lhs, MemoryLocation rhs);
+
+  /// Returns true if 'def' completely overwrites the memory written by 'store'.
+  bool overwrites(pylir::MemSSA::MemoryDefOp def, Operation* store);
+
+  /// Returns true if every path following 'storeDef' reaches a def
+  /// overwriting the memory written by it before exiting the function.
+  bool isOverwrittenOnAllPaths(pylir::MemSSA::MemoryDefOp storeDef);
+
+  /// Returns true if the memory written by 'store' is overwritten on every path
+  /// prior to any possible read.
+  bool isOverwritten(pylir::MemSSA::MemoryDefOp storeDef);
+
+protected:
+  void runOnOperation() override;
+
+public:
+  using Base::Base;
+};
+
+pylir::MemSSA::MemoryDefOp
+DeadStoreEliminationPass::getStoreDef(Operation* op) {
+  if (op->getNumResults() != 0 || op->hasTrait<OpTrait::IsTerminator>())
+    return nullptr;
+
+  auto memoryEffectOp = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!memoryEffectOp)
+    return nullptr;
+
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  memoryEffectOp.getEffects(effects);
+  if (effects.empty() ||
+      !llvm::all_of(effects, [](const MemoryEffects::EffectInstance& effect) {
+        return isa<MemoryEffects::Write>(effect.getEffect()) &&
+               (effect.getValue() || effect.getSymbolRef());
+      }))
+    return nullptr;
+
+  ArrayRef<Operation*> accesses = m_memorySSA->getMemoryAccesses(op);
+  if (accesses.size() != 1)
+    return nullptr;
+  return dyn_cast<pylir::MemSSA::MemoryDefOp>(accesses.front());
+}
+
+bool DeadStoreEliminationPass::isUnreadObject(Value object) {
+  Operation* defOp = object.getDefiningOp();
+  if (!defOp || !hasEffect<MemoryEffects::Allocate>(defOp, object))
+    return false;
+
+  for (OpOperand& use : object.getUses()) {
+    Operation* user = use.getOwner();
+    auto capture = dyn_cast<pylir::CaptureInterface>(user);
+    if (!capture || capture.capturesValue(object))
+      return false;
+
+    if (getStoreDef(user))
+      continue;
+
+    // Operands only reading the value part of an object never read memory
+    // written after creation of the object, as the interface may only be
+    // attached to operations on immutable objects.
+    auto onlyReadsValue = dyn_cast<pylir::Py::OnlyReadsValueInterface>(user);
+    if (onlyReadsValue && onlyReadsValue.onlyReadsValue(use))
+      continue;
+
+    auto memoryEffectOp = dyn_cast<MemoryEffectOpInterface>(user);
+    if (!memoryEffectOp)
+      return false;
+
+    SmallVector<MemoryEffects::EffectInstance> effects;
+    memoryEffectOp.getEffects(effects);
+    if (llvm::any_of(effects, [&](const MemoryEffects::EffectInstance& effect) {
+          return isa<MemoryEffects::Read>(effect.getEffect()) &&
+                 (!effect.getValue() || effect.getValue() == object);
+        }))
+      return false;
+  }
+  return true;
+}
+
+bool DeadStoreEliminationPass::mayAlias(MemoryLocation lhs,
+                                        MemoryLocation rhs) {
+  if (!lhs || !rhs)
+    return true;
+
+  auto lhsValue = dyn_cast<Value>(lhs);
+  auto rhsValue = dyn_cast<Value>(rhs);
+  if (lhsValue && rhsValue)
+    return !m_aliasAnalysis->alias(lhsValue, rhsValue).isNo();
+
+  // Symbols only alias each other if they are the same. A mix of symbols and
+  // values is conservatively assumed to alias, matching 'MemorySSA'.
+  if (!lhsValue && !rhsValue)
+    return lhs == rhs;
+  return true;
+}
+
+bool DeadStoreEliminationPass::overwrites(pylir::MemSSA::MemoryDefOp def,
+                                          Operation* store) {
+  Operation* instruction = def.getInstruction();
+  if (instruction->getName() != store->getName() || !getStoreDef(instruction))
+    return false;
+
+  // Stores to globals write the whole symbol.
+  auto storeDef = cast<pylir::MemSSA::MemoryDefOp>(
+      m_memorySSA->getMemoryAccesses(store).front());
+  if (storeDef.getWrites().size() == 1 &&
+      isa<SymbolRefAttr>(storeDef.getWrites().front()))
+    return def.getWrites().size() == 1 &&
+           def.getWrites().front() == storeDef.getWrites().front();
+
+  // Stores to aggregates have to write the same statically known key of an
+  // aggregate that is known to be the same.
+  auto lhs = dyn_cast<pylir::SROAReadWriteOpInterface>(instruction);
+  auto rhs = dyn_cast<pylir::SROAReadWriteOpInterface>(store);
+  if (!lhs || !rhs)
+    return false;
+
+  FailureOr<Attribute> lhsKey = lhs.getSROAKey();
+  FailureOr<Attribute> rhsKey = rhs.getSROAKey();
+  if (failed(lhsKey) || failed(rhsKey) || !*lhsKey || *lhsKey != *rhsKey)
+    return false;
+
+  return m_aliasAnalysis
+      ->alias(lhs.getAggregateOperand().get(), rhs.getAggregateOperand().get())
+      .isMust();
+}
+
+bool DeadStoreEliminationPass::isOverwrittenOnAllPaths(
+    pylir::MemSSA::MemoryDefOp storeDef) {
+  Operation* store = storeDef.getInstruction();
+  SmallVector<Block*> worklist;
+  llvm::DenseSet<Block*> seen;
+  Block* block = storeDef->getBlock();
+  Block::iterator begin = std::next(storeDef->getIterator());
+  while (true) {
+    bool overwritten =
+        llvm::any_of(llvm::make_range(begin, block->end()), [&](Operation& op) {
+          auto def = dyn_cast<pylir::MemSSA::MemoryDefOp>(&op);
+          return def && overwrites(def, store);
+        });
+    if (!overwritten) {
+      // Reaching the end of the function makes the memory visible to the
+      // caller.
+      auto branch =
+          dyn_cast<pylir::MemSSA::MemoryBranchOp>(block->getTerminator());
+      if (!branch || branch->getNumSuccessors() == 0)
+        return false;
+
+      for (Block* successor : branch->getSuccessors())
+        if (seen.insert(successor).second)
+          worklist.push_back(successor);
+    }
+
+    if (worklist.empty())
+      return true;
+    block = worklist.pop_back_val();
+    begin = block->begin();
+  }
+}
+
+bool DeadStoreEliminationPass::isOverwritten(
+    pylir::MemSSA::MemoryDefOp storeDef) {
+  // Blocks with a single predecessor do not receive a block argument for the
+  // memory state. Paths through blocks without any memory access are therefore
+  // not visited by the walk over the users below.
+  if (!isOverwrittenOnAllPaths(storeDef))
+    return false;
+
+  Operation* store = storeDef.getInstruction();
+  auto mayAccess = [&](ArrayRef<MemoryLocation> locations) {
+    return llvm::any_of(locations, [&](MemoryLocation location) {
+      return llvm::any_of(storeDef.getWrites(), [&](MemoryLocation write) {
+        return mayAlias(location, write);
+      });
+    });
+  };
+
+  SmallVector<pylir::MemSSA::MemoryDefOp> worklist{storeDef};
+  while (!worklist.empty()) {
+    pylir::MemSSA::MemoryDefOp current = worklist.pop_back_val();
+    for (Operation* user : current->getUsers()) {
+      if (auto use = dyn_cast<pylir::MemSSA::MemoryUseOp>(user)) {
+        if (mayAccess(use.getReads()))
+          return false;
+        continue;
+      }
+
+      // Block arguments merging definitions are conservatively treated as
+      // reads.
+      auto def = dyn_cast<pylir::MemSSA::MemoryDefOp>(user);
+      if (!def)
+        return false;
+
+      if (overwrites(def, store))
+        continue;
+
+      // Other writes to the same location are treated as reads as well. This
+      // keeps e.g. the insertion order of dictionaries intact.
+      if (mayAccess(def.getReads()) || mayAccess(def.getWrites()))
+        return false;
+
+      worklist.push_back(def);
+    }
+  }
+  return true;
+}
+
+void DeadStoreEliminationPass::runOnOperation() {
+  m_memorySSA = &getAnalysis<pylir::MemorySSA>();
+  m_aliasAnalysis = &getAnalysis<AliasAnalysis>();
+
+  SmallVector<pylir::MemSSA::MemoryDefOp> storeDefs;
+  m_memorySSA->getMemoryRegion().walk([&](pylir::MemSSA::MemoryDefOp def) {
+    if (getStoreDef(def.getInstruction()) == def)
+      storeDefs.push_back(def);
+  });
+
+  getOperation()->walk([&](Operation* op) {
+    for (Value result : op->getResults())
+      if (isUnreadObject(result))
+        m_unreadObjects.insert(result);
+  });
+
+  bool changed = false;
+  for (pylir::MemSSA::MemoryDefOp storeDef : storeDefs) {
+    Operation* store = storeDef.getInstruction();
+    bool writesUnreadObjects =
+        llvm::all_of(storeDef.getWrites(), [&](MemoryLocation write) {
+          auto value = dyn_cast_if_present<Value>(write);
+          return value && m_unreadObjects.contains(value);
+        });
+    if (!writesUnreadObjects && !isOverwritten(storeDef))
+      continue;
+
+    m_memorySSA->removeMemoryAccesses(store);
+    store->erase();
+    m_storesRemoved++;
+    changed = true;
+  }
+
+  m_unreadObjects.clear();
+  m_memorySSA = nullptr;
+  m_aliasAnalysis = nullptr;
+  if (!changed) {
+    markAllAnalysesPreserved();
+    return;
+  }
+  // Only operations were erased, the CFG remains unchanged.
+  markAnalysesPreserved<DominanceInfo, pylir::MemorySSA>();
+}
+
+} // namespace
@@ -6,6 +6,8 @@
 
 #include <llvm/Support/BLAKE3.h>
 
+#include <optional>
+
 #include "Passes.hpp"
 
 namespace pylir {
@@ -14,8 +16,20 @@ namespace pylir {
 } // namespace pylir
 
 namespace {
+
+/// Empty analysis used to detect whether the optimization pipeline changed the
+/// IR. It remains cached if every pass in the pipeline preserved all analyses.
+struct ChangeSentinel {
+  explicit ChangeSentinel(mlir::Operation*) {}
+};
+
 class FixpointPass : public pylir::impl::FixpointPassBase<FixpointPass> {
   mlir::OpPassManager m_passManager;
+  /// True if a fixpoint was previously only detected through fingerprints. The
+  /// pipeline then contains passes that do not preserve analyses when leaving
+  /// the IR unchanged and the fingerprint prior to the first iteration is
+  /// required as well.
+  bool m_requiresFingerprint = false;
 
   void runOnOperation() override;
 
@@ -71,17 +85,29 @@ public:
 };
 
 void FixpointPass::runOnOperation() {
-  auto startFingerprint = getFingerprint();
+  std::optional<llvm::BLAKE3Result<>> startFingerprint;
+  if (m_requiresFingerprint)
+    startFingerprint = getFingerprint();
+
   for (std::size_t i = 0; i < m_maxIterationCount; i++) {
+    getAnalysis<ChangeSentinel>();
     if (mlir::failed(runPipeline(m_passManager, getOperation()))) {
       signalPassFailure();
       return;
     }
-    auto endFingerPrint = getFingerprint();
-    if (endFingerPrint == startFingerprint)
+    // Any analysis still cached is valid for the IR after the last iteration.
+    if (getCachedAnalysis<ChangeSentinel>()) {
+      m_fixpointsFromPreservedAnalyses++;
+      markAllAnalysesPreserved();
       return;
+    }
 
-    startFingerprint = endFingerPrint;
+    auto endFingerprint = getFingerprint();
+    if (endFingerprint == startFingerprint) {
+      m_requiresFingerprint = true;
+      return;
+    }
+    startFingerprint = endFingerprint;
   }
   m_maxIterationReached++;
 }
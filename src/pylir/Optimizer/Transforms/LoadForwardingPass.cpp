@@ -32,16 +32,26 @@ void LoadForwardingPass::runOnOperation() {
   auto& aliasAnalysis = getAnalysisManager().getAnalysis<mlir::AliasAnalysis>();
   bool changed = false;
 
-  memorySSA.getMemoryRegion().walk([&](pylir::MemSSA::MemoryUseOp use) {
+  // Uses are collected upfront as erasing an instruction also erases all its
+  // memory accesses.
+  llvm::SmallVector<pylir::MemSSA::MemoryUseOp> uses;
+  memorySSA.getMemoryRegion().walk(
+      [&](pylir::MemSSA::MemoryUseOp use) { uses.push_back(use); });
+  llvm::SmallPtrSet<mlir::Operation*, 8> erased;
+
+  for (pylir::MemSSA::MemoryUseOp use : uses) {
+    if (erased.contains(use.getOperation()))
+      continue;
+
     auto memoryFold =
         mlir::dyn_cast<pylir::MemoryFoldInterface>(use.getInstruction());
     if (!memoryFold)
-      return;
+      continue;
 
     auto defOp =
         use.getDefinition().getDefiningOp<pylir::MemSSA::MemoryDefOp>();
     if (!defOp)
-      return;
+      continue;
 
     // For every read, check that each is defined by the memDef. In other words,
     // that the memDef definitely writes to each of them (potentially via
@@ -54,14 +64,15 @@ void LoadForwardingPass::runOnOperation() {
     // TODO: If there is ever an op with multiple writes it'll likely be
     // necessary to communicate to
     //       MemoryFoldInterface, which write affected a read value.
-    for (const auto& read : use.getReads()) {
-      if (!read) {
-        // If the read is just a general read, not to a specific location, there
-        // is absolutely no way to figure out whether it definitely reads from
-        // the def.
-        return;
-      }
-      if (!llvm::any_of(
+    auto isDefinedByDef =
+        [&](llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr> read) {
+          // If the read is just a general read, not to a specific location,
+          // there is absolutely no way to figure out whether it definitely
+          // reads from the def.
+          if (!read)
+            return false;
+
+          return llvm::any_of(
               defOp.getWrites(),
               [&](llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr> ptr) {
                 if (!ptr)
@@ -75,14 +86,14 @@ void LoadForwardingPass::runOnOperation() {
                   return aliasAnalysis.alias(redVal, writeVal).isMust();
                 }
                 return llvm::isa<mlir::SymbolRefAttr>(ptr) && ptr == read;
-              })) {
-        return;
-      }
-    }
+              });
+        };
+    if (!llvm::all_of(use.getReads(), isDefinedByDef))
+      continue;
 
     llvm::SmallVector<mlir::OpFoldResult> results;
     if (mlir::failed(memoryFold.foldUsage(defOp.getInstruction(), results)))
-      return;
+      continue;
 
     changed = true;
     for (auto [foldResult, opResult] :
@@ -100,10 +111,12 @@ void LoadForwardingPass::runOnOperation() {
       }
     }
     if (mlir::isOpTriviallyDead(memoryFold)) {
+      erased.insert(memorySSA.getMemoryAccesses(memoryFold).begin(),
+                    memorySSA.getMemoryAccesses(memoryFold).end());
+      memorySSA.removeMemoryAccesses(memoryFold);
       memoryFold->erase();
-      use.erase();
     }
-  });
+  }
 
   if (!changed) {
     markAllAnalysesPreserved();
@@ -0,0 +1,192 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <mlir/IR/Dominance.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+
+#include <pylir/Optimizer/Analysis/LoopInfo.hpp>
+#include <pylir/Optimizer/Analysis/MemorySSA.hpp>
+
+#include "Passes.hpp"
+
+namespace pylir {
+#define GEN_PASS_DEF_LOOPINVARIANTCODEMOTIONPASS
+#include "pylir/Optimizer/Transforms/Passes.h.inc"
+} // namespace pylir
+
+using namespace mlir;
+
+namespace {
+
+/// Hoists operations whose operands and read memory do not change within a
+/// loop into the preheader of the loop.
+///
+/// Invariance of memory reads is proven using 'MemorySSA': All definitions
+/// clobbering a read must be outside of the loop. As all resources
+/// ('GlobalResource', 'ObjectResource' etc.) are tracked separately, writes to
+/// e.g. lists within a loop do not prevent hoisting a load of a global.
+class LoopInvariantCodeMotionPass
+    : public pylir::impl::LoopInvariantCodeMotionPassBase<
+          LoopInvariantCodeMotionPass> {
+
+  pylir::MemorySSA* m_memorySSA = nullptr;
+
+  /// Returns the block that all entry edges into 'loop' originate from, if it
+  /// only branches to the header of the loop.
+  static Block* getPreheader(pylir::Loop* loop);
+
+  /// Returns true if 'op' may be moved out of 'loop' as far as its memory
+  /// effects are concerned.
+  bool isMemoryInvariant(Operation* op, pylir::Loop* loop);
+
+  bool hoistInvariants(pylir::Loop* loop, DominanceInfo& dominanceInfo);
+
+protected:
+  void runOnOperation() override;
+
+public:
+  using Base::Base;
+};
+
+Block* LoopInvariantCodeMotionPass::getPreheader(pylir::Loop* loop) {
+  Block* preheader = nullptr;
+  for (Block* pred : loop->getHeader()->getPredecessors()) {
+    if (loop->contains(pred))
+      continue;
+    if (preheader && preheader != pred)
+      return nullptr;
+    preheader = pred;
+  }
+  if (!preheader || preheader->getTerminator()->getNumSuccessors() != 1)
+    return nullptr;
+  return preheader;
+}
+
+bool LoopInvariantCodeMotionPass::isMemoryInvariant(Operation* op,
+                                                    pylir::Loop* loop) {
+  if (isMemoryEffectFree(op))
+    return true;
+
+  // Only operations exclusively reading memory are hoisted. Any write or
+  // allocation has to remain executed once per iteration.
+  auto memoryEffectOp = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!memoryEffectOp)
+    return false;
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  memoryEffectOp.getEffects(effects);
+  if (!llvm::all_of(effects, [](const MemoryEffects::EffectInstance& effect) {
+        return isa<MemoryEffects::Read>(effect.getEffect());
+      }))
+    return false;
+
+  // The definitions of 'MemorySSA' are always either the instructions writing
+  // to memory or block arguments merging definitions. Block arguments are
+  // conservatively treated as variant as they do not keep track of the block
+  // in the original IR.
+  return llvm::all_of(
+      m_memorySSA->getMemoryAccesses(op), [&](Operation* access) {
+        auto use = dyn_cast<pylir::MemSSA::MemoryUseOp>(access);
+        if (!use)
+          return false;
+
+        Value definition = use.getDefinition();
+        if (definition.getDefiningOp<pylir::MemSSA::MemoryLiveOnEntryOp>())
+          return true;
+        auto defOp = definition.getDefiningOp<pylir::MemSSA::MemoryDefOp>();
+        return defOp && !loop->contains(defOp.getInstruction()->getBlock());
+      });
+}
+
+bool LoopInvariantCodeMotionPass::hoistInvariants(
+    pylir::Loop* loop, DominanceInfo& dominanceInfo) {
+  Block* preheader = getPreheader(loop);
+  if (!preheader)
+    return false;
+
+  // Operations that are not speculatable may only be hoisted if they are
+  // guaranteed to be executed whenever the loop is entered. This is the case
+  // if they are within the header or a block dominating all exits of the loop.
+  SmallVector<Block*> exitingBlocks;
+  for (Block* block : loop->getBlocks())
+    if (llvm::any_of(block->getSuccessors(), [&](Block* successor) {
+          return !loop->contains(successor);
+        }))
+      exitingBlocks.push_back(block);
+
+  auto isGuaranteedToExecute = [&](Block* block) {
+    if (block == loop->getHeader())
+      return true;
+    return !exitingBlocks.empty() &&
+           llvm::all_of(exitingBlocks, [&](Block* exiting) {
+             return dominanceInfo.dominates(block, exiting);
+           });
+  };
+
+  bool changed = false;
+  // Blocks are in reverse post order, hence the definitions of operands are
+  // always visited and possibly hoisted prior to their uses.
+  for (Block* block : loop->getBlocks()) {
+    bool guaranteedToExecute = isGuaranteedToExecute(block);
+    for (Operation& op : llvm::make_early_inc_range(*block)) {
+      if (op.hasTrait<OpTrait::IsTerminator>() || op.getNumRegions() != 0)
+        continue;
+
+      if (!guaranteedToExecute && !isSpeculatable(&op))
+        continue;
+
+      if (llvm::any_of(op.getOperands(), [&](Value operand) {
+            return loop->contains(operand.getParentBlock());
+          }))
+        continue;
+
+      if (!isMemoryInvariant(&op, loop))
+        continue;
+
+      op.moveBefore(preheader->getTerminator());
+      m_memorySSA->moveMemoryAccesses(&op);
+      m_opsHoisted++;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void LoopInvariantCodeMotionPass::runOnOperation() {
+  auto& loopInfo = getAnalysis<pylir::LoopInfo>();
+  SmallVector<pylir::Loop*> loops;
+  for (Region& region : getOperation()->getRegions())
+    for (Block& block : region)
+      if (pylir::Loop* loop = loopInfo.getLoopFor(&block);
+          loop && loop->getHeader() == &block)
+        loops.push_back(loop);
+
+  if (loops.empty()) {
+    markAllAnalysesPreserved();
+    return;
+  }
+
+  m_memorySSA = &getAnalysis<pylir::MemorySSA>();
+
+  // Inner loops are processed first, allowing operations to be hoisted out of
+  // several loops.
+  llvm::stable_sort(loops, [](pylir::Loop* lhs, pylir::Loop* rhs) {
+    return lhs->getLoopDepth() > rhs->getLoopDepth();
+  });
+
+  auto& dominanceInfo = getAnalysis<DominanceInfo>();
+  bool changed = false;
+  for (pylir::Loop* loop : loops)
+    changed |= hoistInvariants(loop, dominanceInfo);
+
+  m_memorySSA = nullptr;
+  if (!changed) {
+    markAllAnalysesPreserved();
+    return;
+  }
+  // Only operations within blocks were moved, the CFG remains unchanged.
+  // 'MemorySSA' is kept up to date while moving.
+  markAnalysesPreserved<DominanceInfo, pylir::LoopInfo, pylir::MemorySSA>();
+}
+
+} // namespace
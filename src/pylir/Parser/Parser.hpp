@@ -22,6 +22,9 @@ class Parser {
 #include "Features.def"
   Lexer m_lexer;
   Lexer::iterator m_current;
+  /// Arena all nodes of the syntax tree currently being parsed are allocated
+  /// in. Handed over to the 'FileInput' once parsing succeeded.
+  std::unique_ptr<Syntax::Arena> m_arena = std::make_unique<Syntax::Arena>();
 
   /// Attempts to peek ahead in the token stream and returns the token if it
   /// matches the given predicate. If it does not match, or there are no more
@@ -129,8 +132,16 @@ class Parser {
   std::optional<Token> expect(TokenType tokenType);
 
   template <class T, class... Args>
-  static std::unique_ptr<T> makeNode(Args&&... args) {
-    return std::unique_ptr<T>(new T{{}, std::forward<Args>(args)...});
+  std::unique_ptr<T> makeNode(Args&&... args) {
+    return std::unique_ptr<T>(
+        new (*m_arena) T{{}, std::forward<Args>(args)...});
+  }
+
+  /// Moves 'node' into the arena of the syntax tree currently being parsed.
+  template <class T>
+  std::unique_ptr<T> allocateNode(T&& node) {
+    static_assert(!std::is_reference_v<T>);
+    return std::unique_ptr<T>(new (*m_arena) T(std::move(node)));
   }
 
   bool lookaheadEquals(tcb::span<const TokenType> tokens);
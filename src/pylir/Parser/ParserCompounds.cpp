@@ -4,6 +4,8 @@
 
 #include "Parser.hpp"
 
+#include <llvm/Support/TimeProfiler.h>
+
 #include <pylir/Diagnostics/DiagnosticMessages.hpp>
 #include <pylir/Support/Functional.hpp>
 
@@ -25,13 +27,20 @@ std::optional<pylir::Syntax::FileInput> pylir::Parser::parseFileInput() {
     vector.insert(vector.end(), std::move_iterator(statement->begin()),
                   std::move_iterator(statement->end()));
   }
-  auto fileInput = Syntax::FileInput{{std::move(vector)}, {}};
+  auto fileInput =
+      Syntax::FileInput{std::move(m_arena), {{}, std::move(vector)}, {}};
+  m_arena = std::make_unique<Syntax::Arena>();
+  llvm::TimeTraceScope scope("SemanticAnalysis");
   SemanticAnalysis(m_lexer.getDiagManager()).visit(fileInput);
   return fileInput;
 }
 
 std::optional<decltype(pylir::Syntax::Suite::statements)>
 pylir::Parser::parseStatement() {
+  // Tokens prior to a statement are never looked at again. Only keeping the
+  // tokens of the current statement alive bounds the memory used by the lexer.
+  m_lexer.discardTokensBefore(m_current);
+
   decltype(pylir::Syntax::Suite::statements) result;
   if (peekedIs(firstInCompoundStmt)) {
     auto compound = parseCompoundStmt();
@@ -88,49 +97,49 @@ pylir::Parser::parseCompoundStmt() {
     if (!ifStmt)
       return std::nullopt;
 
-    return std::make_unique<Syntax::IfStmt>(std::move(*ifStmt));
+    return allocateNode(std::move(*ifStmt));
   }
   case TokenType::ForKeyword: {
     auto forStmt = parseForStmt();
     if (!forStmt)
       return std::nullopt;
 
-    return std::make_unique<Syntax::ForStmt>(std::move(*forStmt));
+    return allocateNode(std::move(*forStmt));
   }
   case TokenType::TryKeyword: {
     auto tryStmt = parseTryStmt();
     if (!tryStmt)
       return std::nullopt;
 
-    return std::make_unique<Syntax::TryStmt>(std::move(*tryStmt));
+    return allocateNode(std::move(*tryStmt));
   }
   case TokenType::WithKeyword: {
     auto withStmt = parseWithStmt();
     if (!withStmt)
       return std::nullopt;
 
-    return std::make_unique<Syntax::WithStmt>(std::move(*withStmt));
+    return allocateNode(std::move(*withStmt));
   }
   case TokenType::WhileKeyword: {
     auto whileStmt = parseWhileStmt();
     if (!whileStmt)
       return std::nullopt;
 
-    return std::make_unique<Syntax::WhileStmt>(std::move(*whileStmt));
+    return allocateNode(std::move(*whileStmt));
   }
   case TokenType::DefKeyword: {
     auto funcDef = parseFuncDef({}, std::nullopt);
     if (!funcDef)
       return std::nullopt;
 
-    return std::make_unique<Syntax::FuncDef>(std::move(*funcDef));
+    return allocateNode(std::move(*funcDef));
   }
   case TokenType::ClassKeyword: {
     auto classDef = parseClassDef({});
     if (!classDef)
       return std::nullopt;
 
-    return std::make_unique<Syntax::ClassDef>(std::move(*classDef));
+    return allocateNode(std::move(*classDef));
   }
   case TokenType::AtSign: {
     std::vector<Syntax::Decorator> decorators;
@@ -151,7 +160,7 @@ pylir::Parser::parseCompoundStmt() {
       if (!func)
         return std::nullopt;
 
-      return std::make_unique<Syntax::FuncDef>(std::move(*func));
+      return allocateNode(std::move(*func));
     }
     if (m_current == m_lexer.end()) {
       createError(endOfFileLoc(), Diag::EXPECTED_N, "class or function")
@@ -164,14 +173,14 @@ pylir::Parser::parseCompoundStmt() {
       if (!func)
         return std::nullopt;
 
-      return std::make_unique<Syntax::FuncDef>(std::move(*func));
+      return allocateNode(std::move(*func));
     }
     case TokenType::ClassKeyword: {
       auto clazz = parseClassDef(std::move(decorators));
       if (!clazz)
         return std::nullopt;
 
-      return std::make_unique<Syntax::ClassDef>(std::move(*clazz));
+      return allocateNode(std::move(*clazz));
     }
     case TokenType::SyntaxError: return std::nullopt;
     default: {
@@ -194,21 +203,21 @@ pylir::Parser::parseCompoundStmt() {
       auto func = parseFuncDef({}, async);
       if (!func)
         return std::nullopt;
-      return std::make_unique<Syntax::FuncDef>(std::move(*func));
+      return allocateNode(std::move(*func));
     }
     case TokenType::ForKeyword: {
       auto forStmt = parseForStmt();
       if (!forStmt)
         return std::nullopt;
       forStmt->maybeAsyncKeyword = async;
-      return std::make_unique<Syntax::ForStmt>(std::move(*forStmt));
+      return allocateNode(std::move(*forStmt));
     }
     case TokenType::WithKeyword: {
       auto withStmt = parseWithStmt();
       if (!withStmt)
         return std::nullopt;
       withStmt->maybeAsyncKeyword = async;
-      return std::make_unique<Syntax::WithStmt>(std::move(*withStmt));
+      return allocateNode(std::move(*withStmt));
     }
     case TokenType::SyntaxError: return std::nullopt;
     default: {
@@ -239,7 +248,7 @@ std::optional<pylir::Syntax::IfStmt::Else> pylir::Parser::parseElse() {
     return std::nullopt;
   return Syntax::IfStmt::Else{
       elseKeyowrd, *elseColon,
-      std::make_unique<Syntax::Suite>(std::move(*elseSuite))};
+      allocateNode(std::move(*elseSuite))};
 }
 
 std::optional<pylir::Syntax::IfStmt> pylir::Parser::parseIfStmt() {
@@ -267,7 +276,7 @@ std::optional<pylir::Syntax::IfStmt> pylir::Parser::parseIfStmt() {
     if (!elIfSuite)
       return std::nullopt;
     elifs.push_back({*elif, std::move(*condition), *elifColon,
-                     std::make_unique<Syntax::Suite>(std::move(*elIfSuite))});
+                     allocateNode(std::move(*elIfSuite))});
   }
   std::optional<Syntax::IfStmt::Else> elseSection;
   if (peekedIs(TokenType::ElseKeyword)) {
@@ -280,7 +289,7 @@ std::optional<pylir::Syntax::IfStmt> pylir::Parser::parseIfStmt() {
                         *ifKeyword,
                         std::move(*assignment),
                         *colon,
-                        std::make_unique<Syntax::Suite>(std::move(*suite)),
+                        allocateNode(std::move(*suite)),
                         std::move(elifs),
                         std::move(elseSection)};
 }
@@ -309,7 +318,7 @@ std::optional<pylir::Syntax::WhileStmt> pylir::Parser::parseWhileStmt() {
                            *whileKeyword,
                            std::move(*condition),
                            *colon,
-                           std::make_unique<Syntax::Suite>(std::move(*suite)),
+                           allocateNode(std::move(*suite)),
                            std::move(elseSection)};
 }
 
@@ -346,7 +355,7 @@ std::optional<pylir::Syntax::ForStmt> pylir::Parser::parseForStmt() {
                          *inKeyword,
                          std::move(*expressionList),
                          *colon,
-                         std::make_unique<Syntax::Suite>(std::move(*suite)),
+                         allocateNode(std::move(*suite)),
                          std::move(elseSection)};
 }
 
@@ -371,13 +380,13 @@ std::optional<pylir::Syntax::TryStmt> pylir::Parser::parseTryStmt() {
         {},
         *tryKeyword,
         *colon,
-        std::make_unique<Syntax::Suite>(std::move(*suite)),
+        allocateNode(std::move(*suite)),
         {},
         std::nullopt,
         std::nullopt,
         Syntax::TryStmt::Finally{
             *finallyKeyword, *finallyColon,
-            std::make_unique<Syntax::Suite>(std::move(*finallySuite))}};
+            allocateNode(std::move(*finallySuite))}};
   }
 
   std::optional<Syntax::TryStmt::ExceptAll> catchAll;
@@ -397,7 +406,7 @@ std::optional<pylir::Syntax::TryStmt> pylir::Parser::parseTryStmt() {
       if (!exceptSuite)
         return std::nullopt;
       catchAll = {*exceptKeyword, *exceptColon,
-                  std::make_unique<Syntax::Suite>(std::move(*exceptSuite))};
+                  allocateNode(std::move(*exceptSuite))};
       continue;
     }
     auto expression = parseExpression();
@@ -418,7 +427,7 @@ std::optional<pylir::Syntax::TryStmt> pylir::Parser::parseTryStmt() {
       return std::nullopt;
     exceptSections.push_back(
         {*exceptKeyword, std::move(*expression), std::move(name), *exceptColon,
-         std::make_unique<Syntax::Suite>(std::move(*exceptSuite))});
+         allocateNode(std::move(*exceptSuite))});
   } while (peekedIs(TokenType::ExceptKeyword));
 
   std::optional<Syntax::IfStmt::Else> elseSection;
@@ -439,12 +448,12 @@ std::optional<pylir::Syntax::TryStmt> pylir::Parser::parseTryStmt() {
       return std::nullopt;
     finally = Syntax::TryStmt::Finally{
         *finallyKeyword, *finallyColon,
-        std::make_unique<Syntax::Suite>(std::move(*finallySuite))};
+        allocateNode(std::move(*finallySuite))};
   }
   return Syntax::TryStmt{{},
                          *tryKeyword,
                          *colon,
-                         std::make_unique<Syntax::Suite>(std::move(*suite)),
+                         allocateNode(std::move(*suite)),
                          std::move(exceptSections),
                          std::move(catchAll),
                          std::move(elseSection),
@@ -480,7 +489,7 @@ std::optional<pylir::Syntax::WithStmt> pylir::Parser::parseWithStmt() {
   return Syntax::WithStmt{
       {},           std::nullopt,
       *withKeyword, std::move(withItems),
-      *colon,       std::make_unique<Syntax::Suite>(std::move(*suite))};
+      *colon,       allocateNode(std::move(*suite))};
 }
 
 std::optional<pylir::Syntax::Suite> pylir::Parser::parseSuite() {
@@ -503,7 +512,7 @@ std::optional<pylir::Syntax::Suite> pylir::Parser::parseSuite() {
     auto dedent = expect(TokenType::Dedent);
     if (!dedent)
       return std::nullopt;
-    return Syntax::Suite{std::move(statements)};
+    return Syntax::Suite{{}, std::move(statements)};
   }
 
   auto statementList = parseStmtList();
@@ -515,7 +524,7 @@ std::optional<pylir::Syntax::Suite> pylir::Parser::parseSuite() {
   statements.insert(statements.end(),
                     std::move_iterator(statementList->begin()),
                     std::move_iterator(statementList->end()));
-  return Syntax::Suite{std::move(statements)};
+  return Syntax::Suite{{}, std::move(statements)};
 }
 
 std::optional<std::vector<pylir::Syntax::Parameter>>
@@ -719,7 +728,7 @@ pylir::Parser::parseFuncDef(std::vector<Syntax::Decorator>&& decorators,
                          *closeParenth,
                          std::move(suffix),
                          *colon,
-                         std::make_unique<Syntax::Suite>(std::move(*suite)),
+                         allocateNode(std::move(*suite)),
                          {}};
 }
 
@@ -760,6 +769,6 @@ pylir::Parser::parseClassDef(std::vector<Syntax::Decorator>&& decorators) {
                           IdentifierToken{std::move(*className)},
                           std::move(inheritance),
                           *colon,
-                          std::make_unique<Syntax::Suite>(std::move(*suite)),
+                          allocateNode(std::move(*suite)),
                           {}};
 }
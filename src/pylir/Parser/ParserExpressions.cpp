@@ -131,7 +131,7 @@ pylir::Parser::parseEnclosure() {
       auto closeParentheses = expect(TokenType::CloseParentheses);
       if (!closeParentheses)
         return std::nullopt;
-      return std::make_unique<Syntax::Yield>(std::move(*yield));
+      return allocateNode(std::move(*yield));
     }
 
     if (firstInStarredItem(m_current->getTokenType()) &&
@@ -587,7 +587,7 @@ pylir::Parser::parsePrimary() {
   auto performIntrinsicCheck = [&] {
     if (std::optional<Syntax::Intrinsic> intrinsic =
             checkForIntrinsic(*current))
-      current = std::make_unique<Syntax::Intrinsic>(std::move(*intrinsic));
+      current = allocateNode(std::move(*intrinsic));
   };
 
   while (peekedIs({TokenType::Dot, TokenType::OpenParentheses,
@@ -597,8 +597,7 @@ pylir::Parser::parsePrimary() {
       auto attributeRef = parseAttributeRef(std::move(current));
       if (!attributeRef)
         return std::nullopt;
-      current =
-          std::make_unique<Syntax::AttributeRef>(std::move(*attributeRef));
+      current = allocateNode(std::move(*attributeRef));
       break;
     }
     case TokenType::OpenSquareBracket: {
@@ -616,7 +615,7 @@ pylir::Parser::parsePrimary() {
       auto call = parseCall(std::move(current));
       if (!call)
         return std::nullopt;
-      current = std::make_unique<Syntax::Call>(std::move(*call));
+      current = allocateNode(std::move(*call));
       break;
     }
     default: PYLIR_UNREACHABLE;
@@ -686,7 +685,7 @@ pylir::Parser::parsePower() {
     auto await = parseAwaitExpr();
     if (!await)
       return std::nullopt;
-    expression = std::make_unique<Syntax::UnaryOp>(std::move(*await));
+    expression = allocateNode(std::move(*await));
   } else {
     auto primary = parsePrimary();
     if (!primary)
@@ -876,7 +875,7 @@ pylir::Parser::parseExpression() {
   auto lambda = parseLambdaExpression();
   if (!lambda)
     return std::nullopt;
-  return std::make_unique<Syntax::Lambda>(std::move(*lambda));
+  return allocateNode(std::move(*lambda));
 }
 
 std::optional<pylir::Syntax::Lambda> pylir::Parser::parseLambdaExpression() {
@@ -952,9 +951,13 @@ std::optional<pylir::Syntax::CompFor> pylir::Parser::parseCompFor() {
     return std::nullopt;
   if (!peekedIs({TokenType::ForKeyword, TokenType::IfKeyword,
                  TokenType::AwaitKeyword}))
-    return Syntax::CompFor{std::move(awaitToken),  std::move(*forToken),
-                           std::move(*targetList), std::move(*inToken),
-                           std::move(*orTest),     std::monostate{}};
+    return Syntax::CompFor{{},
+                           std::move(awaitToken),
+                           std::move(*forToken),
+                           std::move(*targetList),
+                           std::move(*inToken),
+                           std::move(*orTest),
+                           std::monostate{}};
 
   std::variant<std::monostate, std::unique_ptr<Syntax::CompFor>,
                std::unique_ptr<Syntax::CompIf>>
@@ -963,16 +966,20 @@ std::optional<pylir::Syntax::CompFor> pylir::Parser::parseCompFor() {
     auto compIf = parseCompIf();
     if (!compIf)
       return std::nullopt;
-    trail = std::make_unique<Syntax::CompIf>(std::move(*compIf));
+    trail = allocateNode(std::move(*compIf));
   } else {
     auto compFor = parseCompFor();
     if (!compFor)
       return std::nullopt;
-    trail = std::make_unique<Syntax::CompFor>(std::move(*compFor));
+    trail = allocateNode(std::move(*compFor));
   }
-  return Syntax::CompFor{std::move(awaitToken),  std::move(*forToken),
-                         std::move(*targetList), std::move(*inToken),
-                         std::move(*orTest),     std::move(trail)};
+  return Syntax::CompFor{{},
+                         std::move(awaitToken),
+                         std::move(*forToken),
+                         std::move(*targetList),
+                         std::move(*inToken),
+                         std::move(*orTest),
+                         std::move(trail)};
 }
 
 std::optional<pylir::Syntax::CompIf> pylir::Parser::parseCompIf() {
@@ -984,7 +991,7 @@ std::optional<pylir::Syntax::CompIf> pylir::Parser::parseCompIf() {
     return std::nullopt;
   if (!peekedIs({TokenType::ForKeyword, TokenType::IfKeyword,
                  TokenType::AwaitKeyword}))
-    return Syntax::CompIf{std::move(*ifToken), std::move(*orTest),
+    return Syntax::CompIf{{}, std::move(*ifToken), std::move(*orTest),
                           std::monostate{}};
 
   std::variant<std::monostate, std::unique_ptr<Syntax::CompFor>,
@@ -994,14 +1001,14 @@ std::optional<pylir::Syntax::CompIf> pylir::Parser::parseCompIf() {
     auto compIf = parseCompIf();
     if (!compIf)
       return std::nullopt;
-    trail = std::make_unique<Syntax::CompIf>(std::move(*compIf));
+    trail = allocateNode(std::move(*compIf));
   } else {
     auto compFor = parseCompFor();
     if (!compFor)
       return std::nullopt;
-    trail = std::make_unique<Syntax::CompFor>(std::move(*compFor));
+    trail = allocateNode(std::move(*compFor));
   }
-  return Syntax::CompIf{std::move(*ifToken), std::move(*orTest),
+  return Syntax::CompIf{{}, std::move(*ifToken), std::move(*orTest),
                         std::move(trail)};
 }
 
@@ -44,7 +44,7 @@ pylir::Parser::parseAssignmentStmt(IntrVarPtr<Syntax::Target>&& firstItem) {
         {},
         std::move(targets),
         nullptr,
-        std::make_unique<Syntax::Yield>(std::move(*yieldExpr))};
+        allocateNode(std::move(*yieldExpr))};
   }
 
   auto starredExpression = parseStarredExpression();
@@ -64,7 +64,7 @@ pylir::Parser::parseSimpleStmt() {
     auto assertStmt = parseAssertStmt();
     if (!assertStmt)
       return std::nullopt;
-    return std::make_unique<Syntax::AssertStmt>(std::move(*assertStmt));
+    return allocateNode(std::move(*assertStmt));
   }
   case TokenType::PassKeyword:
   case TokenType::BreakKeyword:
@@ -93,7 +93,7 @@ pylir::Parser::parseSimpleStmt() {
     if (!yieldExpr)
       return std::nullopt;
     return makeNode<Syntax::ExpressionStmt>(
-        std::make_unique<Syntax::Yield>(std::move(*yieldExpr)));
+        allocateNode(std::move(*yieldExpr)));
   }
   case TokenType::RaiseKeyword: {
     auto raise = *m_current++;
@@ -167,7 +167,7 @@ pylir::Parser::parseSimpleStmt() {
           fromImportAs->relativeModule.module->identifiers.front(),
           fromImportAs->import, std::move(fromImportAs->imports));
     }
-    return std::make_unique<Syntax::ImportStmt>(std::move(*import));
+    return allocateNode(std::move(*import));
   }
   case TokenType::SyntaxError: return std::nullopt;
   default:
@@ -188,8 +188,7 @@ pylir::Parser::parseSimpleStmt() {
       auto assignmentStmt = parseAssignmentStmt(std::move(*starredExpression));
       if (!assignmentStmt)
         return std::nullopt;
-      return std::make_unique<Syntax::AssignmentStmt>(
-          std::move(*assignmentStmt));
+      return allocateNode(std::move(*assignmentStmt));
     }
     case TokenType::PlusAssignment:
     case TokenType::Colon:
@@ -223,7 +222,7 @@ pylir::Parser::parseSimpleStmt() {
             return std::nullopt;
           return makeNode<Syntax::AssignmentStmt>(
               std::move(vector), std::move(*expression),
-              std::make_unique<Syntax::Yield>(std::move(*yield)));
+              allocateNode(std::move(*yield)));
         }
         auto starred = parseStarredExpression();
         if (!starred)
@@ -240,7 +239,7 @@ pylir::Parser::parseSimpleStmt() {
           return std::nullopt;
         return makeNode<Syntax::AssignmentStmt>(
             std::move(vector), nullptr,
-            std::make_unique<Syntax::Yield>(std::move(*yield)));
+            allocateNode(std::move(*yield)));
       }
       auto expressionList = parseExpressionList();
       if (!expressionList)
@@ -5,12 +5,34 @@
 #pragma once
 
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/Allocator.h>
 
 #include <pylir/Lexer/Token.hpp>
 #include <pylir/Support/AbstractIntrusiveVariant.hpp>
 
+#include <cstddef>
+
 namespace pylir::Syntax {
 
+/// Allocator owning the memory of all nodes of a syntax tree.
+using Arena = llvm::BumpPtrAllocator;
+
+/// Base class of all nodes that are allocated separately from their parent.
+/// These may only be allocated within an 'Arena' using 'new (arena) T'.
+/// Deleting a node calls its destructor but the memory is only released once
+/// the whole 'Arena' is destroyed.
+struct ArenaAllocated {
+  static void* operator new(std::size_t size, Arena& arena) {
+    return arena.Allocate(size, alignof(std::max_align_t));
+  }
+
+  static void operator delete(void*, Arena&) noexcept {}
+
+  static void* operator new(std::size_t) = delete;
+
+  static void operator delete(void*) noexcept {}
+};
+
 struct Expression
     : public AbstractIntrusiveVariant<
           Expression, struct BinOp, struct Atom, struct AttributeRef,
@@ -18,7 +40,8 @@ struct Expression
           struct Conditional, struct Call, struct Lambda, struct UnaryOp,
           struct Yield, struct Generator, struct TupleConstruct,
           struct ListDisplay, struct SetDisplay, struct DictDisplay,
-          struct Comparison, struct Intrinsic> {
+          struct Comparison, struct Intrinsic>,
+      ArenaAllocated {
   using AbstractIntrusiveVariant::AbstractIntrusiveVariant;
 };
 
@@ -116,7 +139,7 @@ struct Argument {
 
 struct CompIf;
 
-struct CompFor {
+struct CompFor : ArenaAllocated {
   std::optional<BaseToken> awaitToken;
   BaseToken forToken;
   IntrVarPtr<Target> targets;
@@ -127,7 +150,7 @@ struct CompFor {
       compIter;
 };
 
-struct CompIf {
+struct CompIf : ArenaAllocated {
   BaseToken ifToken;
   IntrVarPtr<Expression> test;
   std::variant<std::monostate, std::unique_ptr<CompFor>,
@@ -240,7 +263,8 @@ struct SimpleStmt
           SimpleStmt, struct ExpressionStmt, struct AssertStmt,
           struct AssignmentStmt, struct SingleTokenStmt, struct DelStmt,
           struct ReturnStmt, struct RaiseStmt, struct ImportStmt,
-          struct FutureStmt, struct GlobalOrNonLocalStmt> {
+          struct FutureStmt, struct GlobalOrNonLocalStmt>,
+      ArenaAllocated {
   using AbstractIntrusiveVariant::AbstractIntrusiveVariant;
 };
 
@@ -341,7 +365,8 @@ struct Suite;
 struct CompoundStmt
     : AbstractIntrusiveVariant<CompoundStmt, struct IfStmt, struct WhileStmt,
                                struct ForStmt, struct TryStmt, struct WithStmt,
-                               struct FuncDef, struct ClassDef> {
+                               struct FuncDef, struct ClassDef>,
+      ArenaAllocated {
   using AbstractIntrusiveVariant::AbstractIntrusiveVariant;
 };
 
@@ -464,13 +489,16 @@ struct ClassDef : CompoundStmt::Base<ClassDef> {
   bool isExported = false;
 };
 
-struct Suite {
+struct Suite : ArenaAllocated {
   using Variant =
       std::variant<IntrVarPtr<SimpleStmt>, IntrVarPtr<CompoundStmt>>;
   std::vector<Variant> statements;
 };
 
 struct FileInput {
+  /// Arena containing all nodes of the syntax tree. Declared first to outlive
+  /// all of them.
+  std::unique_ptr<Arena> arena;
   Suite input;
   IdentifierSet globals;
 };
@@ -4,9 +4,12 @@
 
 #include "API.hpp"
 
+#include <pylir/Runtime/ExceptionHandling/ExceptionPool.hpp>
 #include <pylir/Runtime/GC/GC.hpp>
+#include <pylir/Runtime/Util/OutputBuffer.hpp>
 
-#include <iostream>
+#include <cstdlib>
+#include <cstring>
 #include <string_view>
 
 using namespace pylir::rt;
@@ -33,10 +36,32 @@ std::size_t pylir_str_hash(PyString& string) {
   return std::hash<std::string_view>{}(string.view());
 }
 
+std::size_t pylir_int_hash(PyInt& integer) {
+  return integer.getInteger().hash();
+}
+
+char* pylir_int_to_str(PyInt& integer, std::size_t& size,
+                       std::size_t& capacity) {
+  const pylir::BigInt& value = integer.getInteger();
+  capacity = value.decimalSizeOverestimate();
+  auto* buffer = static_cast<char*>(std::malloc(capacity));
+  char* end = buffer + capacity;
+  char* start = value.toDecimal(end);
+  size = end - start;
+  std::memmove(buffer, start, size);
+  return buffer;
+}
+
 void pylir_print(PyString& string) {
-  std::cout << string.view();
+  getStdout().write(string.view());
 }
 
 extern "C" void* pylir_gc_alloc(std::size_t size) {
   return pylir::rt::gc.alloc(size);
 }
+
+void* pylir_exception_alloc(PyTypeObject& type, std::size_t size) {
+  if (PyBaseException* pooled = exceptionPool.take(type))
+    return pooled;
+  return pylir::rt::gc.alloc(size);
+}
@@ -12,8 +12,15 @@ extern "C" {
 
 void* pylir_gc_alloc(std::size_t);
 
+void* pylir_exception_alloc(pylir::rt::PyTypeObject& type, std::size_t size);
+
 std::size_t pylir_str_hash(pylir::rt::PyString& string);
 
+std::size_t pylir_int_hash(pylir::rt::PyInt& integer);
+
+char* pylir_int_to_str(pylir::rt::PyInt& integer, std::size_t& size,
+                       std::size_t& capacity);
+
 pylir::rt::PyObject* pylir_dict_lookup(pylir::rt::PyDict& dict,
                                        pylir::rt::PyObject& key,
                                        std::size_t hash);
@@ -30,4 +37,8 @@ void pylir_dict_erase(pylir::rt::PyDict& dict, pylir::rt::PyObject& key,
 void pylir_print(pylir::rt::PyString& string);
 
 void pylir_raise(pylir::rt::PyBaseException& exception);
+
+void pylir_raise_pooled(pylir::rt::PyBaseException& exception);
+
+void pylir_exception_release(pylir::rt::PyBaseException& exception);
 }
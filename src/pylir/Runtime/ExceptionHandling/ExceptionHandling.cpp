@@ -7,11 +7,15 @@
 
 #include <iostream>
 
-void pylir_raise(pylir::rt::PyBaseException& exception) {
+#include "ExceptionPool.hpp"
+
+namespace {
+
+[[noreturn]] void raise(pylir::rt::PyBaseException& exception,
+                        _Unwind_Exception_Cleanup_Fn cleanup) {
   auto& header = exception.getUnwindHeader();
   std::memset(&header, 0, sizeof(header));
-  header.exception_cleanup =
-      +[](_Unwind_Reason_Code, _Unwind_Exception*) { /*NOOP for now*/ };
+  header.exception_cleanup = cleanup;
   header.exception_class = pylir::rt::PyBaseException::EXCEPTION_CLASS;
   auto code = _Unwind_RaiseException(&header);
   switch (code) {
@@ -26,6 +30,30 @@ void pylir_raise(pylir::rt::PyBaseException& exception) {
   }
 }
 
+} // namespace
+
+void pylir_raise(pylir::rt::PyBaseException& exception) {
+  raise(exception,
+        +[](_Unwind_Reason_Code, _Unwind_Exception*) { /*NOOP for now*/ });
+}
+
+void pylir_raise_pooled(pylir::rt::PyBaseException& exception) {
+  // The compiler guarantees that the exception object is only referenced by
+  // the exception being raised. Once a handler is done with it, it can be
+  // reused.
+  raise(exception, +[](_Unwind_Reason_Code, _Unwind_Exception* header) {
+    // Reraising reinstalls the cleanup function. Make sure a second release
+    // does not put the object into the pool twice.
+    header->exception_cleanup = nullptr;
+    pylir::rt::exceptionPool.release(
+        *pylir::rt::PyBaseException::fromUnwindHeader(header));
+  });
+}
+
+void pylir_exception_release(pylir::rt::PyBaseException& exception) {
+  _Unwind_DeleteException(&exception.getUnwindHeader());
+}
+
 namespace {
 
 // Heavily borrowed from llvm/examples/ExceptionDemo/ExceptionDemo.cpp
@@ -0,0 +1,57 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "ExceptionPool.hpp"
+
+pylir::rt::ExceptionPool pylir::rt::exceptionPool;
+
+// The free lists are intrusive. The landing pad field of a pooled object is
+// only ever written by the personality function during unwinding and is
+// therefore free to be used as link to the next object.
+
+pylir::rt::PyBaseException*
+pylir::rt::ExceptionPool::take(PyTypeObject& type) {
+  for (FreeList& freeList : m_freeLists) {
+    if (freeList.type != &type)
+      continue;
+
+    PyBaseException* result = freeList.head;
+    if (!result)
+      return nullptr;
+
+    freeList.head = reinterpret_cast<PyBaseException*>(result->getLandingPad());
+    freeList.size--;
+    return result;
+  }
+  return nullptr;
+}
+
+void pylir::rt::ExceptionPool::release(PyBaseException& exception) {
+  PyTypeObject& exceptionType = type(exception);
+  FreeList* target = nullptr;
+  for (FreeList& freeList : m_freeLists) {
+    if (freeList.type == &exceptionType) {
+      target = &freeList;
+      break;
+    }
+    if (!target && !freeList.head)
+      target = &freeList;
+  }
+  // Objects that do not fit into the pool are simply left to the garbage
+  // collector.
+  if (!target || target->size == MAX_OBJECTS_PER_TYPE)
+    return;
+
+  if (target->type != &exceptionType) {
+    target->type = &exceptionType;
+    target->size = 0;
+  }
+  exception.setLandingPad(reinterpret_cast<std::uintptr_t>(target->head));
+  target->head = &exception;
+  target->size++;
+}
+
+void pylir::rt::ExceptionPool::clear() {
+  m_freeLists.fill(FreeList{});
+}
@@ -0,0 +1,49 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <pylir/Runtime/Objects/Objects.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace pylir::rt {
+
+/// Per-type free lists of exception objects that were raised and caught
+/// without being retained by the program. Exceptions used for control flow,
+/// such as 'StopIteration' terminating a loop, are raised and caught over and
+/// over again. Reusing their objects avoids allocating a new one from the
+/// garbage collector every time.
+///
+/// Objects are only ever put into the pool by the cleanup function installed
+/// by 'pylir_raise_pooled'. The pool is emptied on every garbage collection
+/// which frees the objects contained within.
+class ExceptionPool {
+  constexpr static std::size_t MAX_TYPES = 8;
+  constexpr static std::size_t MAX_OBJECTS_PER_TYPE = 16;
+
+  struct FreeList {
+    PyTypeObject* type = nullptr;
+    PyBaseException* head = nullptr;
+    std::size_t size = 0;
+  };
+  std::array<FreeList, MAX_TYPES> m_freeLists{};
+
+public:
+  /// Returns a previously released exception object of exactly 'type' or null
+  /// if none is available. The object must be reinitialized by the caller.
+  PyBaseException* take(PyTypeObject& type);
+
+  /// Puts 'exception' into the pool. The caller must guarantee that
+  /// 'exception' is no longer referenced by the program.
+  void release(PyBaseException& exception);
+
+  /// Removes all exception objects from the pool.
+  void clear();
+};
+
+extern ExceptionPool exceptionPool;
+
+} // namespace pylir::rt
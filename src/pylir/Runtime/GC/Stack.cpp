@@ -70,6 +70,17 @@
 ///     Callsite callsites[callSiteCount];
 /// };
 ///
+/// If the program was compiled as multiple partitions, every partition has its
+/// own stack map and the 'pylir_stack_map' symbol refers to a table of them
+/// instead:
+///
+/// struct StackmapTable {
+///     uint32_t magic; /// Must contain 0x50594C54, aka the ascii string 'PYLT'
+///                     /// interpreted as uint32_t.
+///     uint32_t count; /// Amount of stack maps.
+///     const Stackmap* stackmaps[count];
+/// };
+///
 
 #include <cstdlib>
 #include <unordered_map>
@@ -86,6 +97,9 @@ namespace {
 /// Magic appearing at the beginning of the stack map as a simple integrity
 /// test.
 constexpr std::uint32_t PYLR_MAGIC = 0x50594C52;
+
+/// Magic appearing at the beginning of a table of stack maps.
+constexpr std::uint32_t PYLT_MAGIC = 0x50594C54;
 } // namespace
 
 /// The stack map symbol with the name used by the compiler.
@@ -216,45 +230,76 @@ public:
   }
 };
 
+/// Parses the stack map at 'curr', appending its reference locations and call
+/// sites to 'referenceLocations' and 'callSites'.
+void parseStackMap(
+    const std::uint8_t* curr,
+    std::vector<ReferenceLocation>& referenceLocations,
+    std::unordered_map<std::uintptr_t, std::vector<std::uint32_t>>& callSites) {
+  std::uint32_t magic;
+  std::memcpy(&magic, curr, sizeof(std::uint32_t));
+  PYLIR_ASSERT(magic == PYLR_MAGIC);
+  curr += sizeof(std::uint32_t);
+
+  // Indices of the call sites are relative to the reference locations of this
+  // stack map.
+  std::size_t indexOffset = referenceLocations.size();
+  referenceLocations.resize(indexOffset + pylir::rt::readULEB128(&curr));
+  for (std::size_t i = indexOffset; i < referenceLocations.size(); i++) {
+    ReferenceLocation& location = referenceLocations[i];
+    location.type = static_cast<ReferenceLocation::Type>(*curr);
+    curr++;
+    location.registerNumber = pylir::rt::readULEB128(&curr);
+    if (location.type != ReferenceLocation::Type::Register)
+      location.offset = pylir::rt::readSLEB128(&curr);
+
+    if (location.type == ReferenceLocation::Type::Indirect) {
+      location.count = *curr;
+      curr++;
+    }
+  }
+
+  std::size_t callSiteCount = pylir::rt::readULEB128(&curr);
+  callSites.reserve(callSites.size() + callSiteCount);
+  for (std::size_t i = 0; i < callSiteCount; i++) {
+    curr = pylir::roundUpTo(curr, alignof(std::uintptr_t));
+    std::uintptr_t programCounter;
+    std::memcpy(&programCounter, curr, sizeof(std::uintptr_t));
+    curr += sizeof(std::uintptr_t);
+
+    std::vector<std::uint32_t> indices(pylir::rt::readULEB128(&curr));
+    for (std::uint32_t& index : indices)
+      index = indexOffset + pylir::rt::readULEB128(&curr);
+
+    callSites.insert_or_assign(programCounter, std::move(indices));
+  }
+}
+
 /// Returns the stack map singleton. Lazily parses in the stack map on first use
 /// and does so in a thread safe manner as well.
 const Stackmap& getStackMap() {
   static Stackmap stackmap = [] {
+    std::vector<ReferenceLocation> referenceLocations;
+    std::unordered_map<std::uintptr_t, std::vector<std::uint32_t>> callSites;
+
     const std::uint8_t* curr = pylir_stack_map;
     std::uint32_t magic;
     std::memcpy(&magic, curr, sizeof(std::uint32_t));
-    PYLIR_ASSERT(magic == PYLR_MAGIC);
-    curr += sizeof(std::uint32_t);
-
-    std::vector<ReferenceLocation> referenceLocations(
-        pylir::rt::readULEB128(&curr));
-    for (ReferenceLocation& location : referenceLocations) {
-      location.type = static_cast<ReferenceLocation::Type>(*curr);
-      curr++;
-      location.registerNumber = pylir::rt::readULEB128(&curr);
-      if (location.type != ReferenceLocation::Type::Register)
-        location.offset = pylir::rt::readSLEB128(&curr);
-
-      if (location.type == ReferenceLocation::Type::Indirect) {
-        location.count = *curr;
-        curr++;
-      }
+    if (magic != PYLT_MAGIC) {
+      parseStackMap(curr, referenceLocations, callSites);
+      return Stackmap(std::move(referenceLocations), std::move(callSites));
     }
 
-    std::size_t callSiteCount = pylir::rt::readULEB128(&curr);
-    std::unordered_map<std::uintptr_t, std::vector<std::uint32_t>> callSites(
-        callSiteCount);
-    for (std::size_t i = 0; i < callSiteCount; i++) {
+    curr += sizeof(std::uint32_t);
+    std::uint32_t count;
+    std::memcpy(&count, curr, sizeof(std::uint32_t));
+    curr += sizeof(std::uint32_t);
+    for (std::uint32_t i = 0; i < count; i++) {
       curr = pylir::roundUpTo(curr, alignof(std::uintptr_t));
-      std::uintptr_t programCounter;
-      std::memcpy(&programCounter, curr, sizeof(std::uintptr_t));
-      curr += sizeof(std::uintptr_t);
-
-      std::vector<std::uint32_t> indices(pylir::rt::readULEB128(&curr));
-      for (std::uint32_t& index : indices)
-        index = pylir::rt::readULEB128(&curr);
-
-      callSites.insert_or_assign(programCounter, std::move(indices));
+      const std::uint8_t* stackMap;
+      std::memcpy(&stackMap, curr, sizeof(const std::uint8_t*));
+      curr += sizeof(const std::uint8_t*);
+      parseStackMap(stackMap, referenceLocations, callSites);
     }
     return Stackmap(std::move(referenceLocations), std::move(callSites));
   }();
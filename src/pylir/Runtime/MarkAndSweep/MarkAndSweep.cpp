@@ -4,10 +4,15 @@
 
 #include "MarkAndSweep.hpp"
 
+#include <pylir/Runtime/ExceptionHandling/ExceptionPool.hpp>
 #include <pylir/Runtime/GC/Globals.hpp>
 #include <pylir/Runtime/GC/Stack.hpp>
+#include <pylir/Runtime/Util/OutputBuffer.hpp>
 #include <pylir/Support/Util.hpp>
 
+#include <cstdlib>
+#include <string>
+
 // Anything below 65535 would do basically as compiler generated initializers
 // have priority 65534.
 pylir::rt::MarkAndSweep pylir::rt::gc __attribute__((init_priority(65534)));
@@ -92,6 +97,12 @@ void mark(std::uintptr_t stackLowerBound, std::uintptr_t stackUpperBound,
 } // namespace
 
 void pylir::rt::MarkAndSweep::collect() {
+  m_collections++;
+
+  // Objects in the exception pool are unreachable by definition. Emptying the
+  // pool lets them be swept like any other garbage.
+  exceptionPool.clear();
+
   std::vector<PyObject*> roots;
   auto [stackLower, stackUpper] = collectStackRoots(roots);
   auto handles = getHandles();
@@ -133,3 +144,12 @@ void pylir::rt::MarkAndSweep::collect() {
   m_unit8.sweep();
   m_tree.sweep();
 }
+
+void pylir::rt::MarkAndSweep::reportStatistics() const {
+  if (!std::getenv("PYLIR_GC_STATS"))
+    return;
+
+  OutputBuffer stderrBuffer(2);
+  stderrBuffer.write("pylir-gc-collections: " + std::to_string(m_collections) +
+                     "\n");
+}
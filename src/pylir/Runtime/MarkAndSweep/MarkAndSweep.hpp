@@ -20,9 +20,15 @@ class MarkAndSweep {
   SegregatedFreeList m_unit6{6 * alignof(MaxAligned)};
   SegregatedFreeList m_unit8{8 * alignof(MaxAligned)};
   BestFitTree m_tree{8 * alignof(MaxAligned)};
+  std::size_t m_collections = 0;
+
+  /// Writes statistics about the collector to stderr if the 'PYLIR_GC_STATS'
+  /// environment variable is set. Used by the runtime benchmarks.
+  void reportStatistics() const;
 
 public:
   ~MarkAndSweep() {
+    reportStatistics();
     m_unit2.finalize();
     m_unit4.finalize();
     m_unit6.finalize();
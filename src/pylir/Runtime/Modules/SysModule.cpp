@@ -3,6 +3,7 @@
 //  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include <pylir/Runtime/Objects/Objects.hpp>
+#include <pylir/Runtime/Util/OutputBuffer.hpp>
 
 using namespace pylir::rt;
 
@@ -20,6 +21,9 @@ PyObject& exceptHookImpl(PyFunction& /*function*/, PyTuple& args,
   if (type.substr(0, sizeof("builtins")) == "builtins.")
     type = type.substr(sizeof("builtins"));
 
+  // Make sure any output of the program so far appears before the exception
+  // message.
+  getStdout().flush();
   std::cerr << type << ": ";
   std::cerr << Builtins::Str(exception).cast<PyString>().view() << std::endl;
   return Builtins::None;
@@ -447,6 +447,10 @@ public:
   T to() {
     return m_integer.getInteger<T>();
   }
+
+  [[nodiscard]] const BigInt& getInteger() const {
+    return m_integer;
+  }
 };
 
 class PyBaseException : public PyObject {
@@ -9,6 +9,11 @@ using namespace pylir::rt;
 #include "Objects.hpp"
 
 std::size_t PyObjectHasher::operator()(PyObject* object) const noexcept {
+  // Fast path for the most common kind of keys besides strings, skipping the
+  // dispatch through '__hash__'. Subclasses may override '__hash__'.
+  if (&type(*object) == &Builtins::Int)
+    return object->cast<PyInt>().getInteger().hash();
+
   return Builtins::Hash(*object).cast<PyInt>().to<std::size_t>();
 }
 
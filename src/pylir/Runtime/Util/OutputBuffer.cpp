@@ -0,0 +1,80 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "OutputBuffer.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+bool isTerminal(int fd) {
+#ifdef _WIN32
+  return _isatty(fd);
+#else
+  return isatty(fd);
+#endif
+}
+
+} // namespace
+
+pylir::rt::OutputBuffer::OutputBuffer(int fd)
+    : m_fd(fd), m_lineBuffered(isTerminal(fd)) {}
+
+void pylir::rt::OutputBuffer::writeUnbuffered(std::string_view data) {
+  while (!data.empty()) {
+#ifdef _WIN32
+    auto written =
+        _write(m_fd, data.data(), static_cast<unsigned>(data.size()));
+#else
+    auto written = ::write(m_fd, data.data(), data.size());
+#endif
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      // Nothing sensible left to do if the output was closed or similar.
+      // Drop the data just like a closed pipe would.
+      return;
+    }
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
+
+void pylir::rt::OutputBuffer::write(std::string_view data) {
+  if (data.size() > BUFFER_SIZE - m_size) {
+    flush();
+    // Data that does not fit into the buffer even when empty is written out
+    // immediately instead of being chunked.
+    if (data.size() >= BUFFER_SIZE) {
+      writeUnbuffered(data);
+      return;
+    }
+  }
+
+  std::memcpy(m_buffer.data() + m_size, data.data(), data.size());
+  m_size += data.size();
+  if (m_lineBuffered && data.find('\n') != std::string_view::npos)
+    flush();
+}
+
+void pylir::rt::OutputBuffer::flush() {
+  if (m_size == 0)
+    return;
+
+  writeUnbuffered({m_buffer.data(), m_size});
+  m_size = 0;
+}
+
+pylir::rt::OutputBuffer& pylir::rt::getStdout() {
+  // Function local static ensures the buffer is constructed on first use and
+  // destroyed, and therefore flushed, at program exit, including 'std::exit'.
+  static OutputBuffer buffer(/*fd=*/1);
+  return buffer;
+}
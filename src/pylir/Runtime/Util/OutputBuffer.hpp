@@ -0,0 +1,52 @@
+//  Licensed under the Apache License v2.0 with LLVM Exceptions.
+//  See https://llvm.org/LICENSE.txt for license information.
+//  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace pylir::rt {
+
+/// Buffered writer on top of a raw file descriptor. Writes are accumulated in a
+/// fixed size buffer and only passed to the OS once the buffer is full, on
+/// explicit calls to 'flush' or on destruction. If the file descriptor refers
+/// to a terminal, the buffer is additionally flushed after every write
+/// containing a newline, matching the line buffering of CPython.
+class OutputBuffer {
+  constexpr static std::size_t BUFFER_SIZE = 64 * 1024;
+
+  std::array<char, BUFFER_SIZE> m_buffer;
+  std::size_t m_size = 0;
+  int m_fd;
+  bool m_lineBuffered;
+
+  /// Writes 'data' directly to the file descriptor, bypassing the buffer.
+  void writeUnbuffered(std::string_view data);
+
+public:
+  explicit OutputBuffer(int fd);
+
+  ~OutputBuffer() {
+    flush();
+  }
+
+  OutputBuffer(const OutputBuffer&) = delete;
+  OutputBuffer& operator=(const OutputBuffer&) = delete;
+  OutputBuffer(OutputBuffer&&) = delete;
+  OutputBuffer& operator=(OutputBuffer&&) = delete;
+
+  /// Appends 'data' to the buffer, flushing as required.
+  void write(std::string_view data);
+
+  /// Writes out any buffered data.
+  void flush();
+};
+
+/// Returns the buffer used for the standard output of the program. It is
+/// flushed at program exit.
+OutputBuffer& getStdout();
+
+} // namespace pylir::rt
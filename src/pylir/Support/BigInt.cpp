@@ -4,10 +4,13 @@
 
 #include "BigInt.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <vector>
 
 #include "Util.hpp"
 
@@ -42,8 +45,168 @@ struct DoubleRepr {
 
 static_assert(sizeof(DoubleRepr) == sizeof(double));
 
+/// Largest power of ten that still fits into a single 'mp_digit' and the amount
+/// of decimal digits it represents. Integers are converted to decimal in chunks
+/// of this size, requiring only a single division per chunk instead of per
+/// digit.
+struct DecimalChunk {
+  mp_digit base;
+  std::size_t digits;
+};
+
+constexpr DecimalChunk DECIMAL_CHUNK = [] {
+  DecimalChunk result{1, 0};
+  while (result.base <= MP_MASK / 10) {
+    result.base *= 10;
+    result.digits++;
+  }
+  return result;
+}();
+
+/// Size in 'mp_digit's from which on integers are converted to decimal by
+/// recursively splitting them in halves. Dividing by a chunk is linear in the
+/// size of the integer, making the chunked conversion quadratic.
+constexpr int DIVIDE_AND_CONQUER_THRESHOLD = 64;
+
+constexpr std::array<char, 200> DIGIT_PAIRS = [] {
+  std::array<char, 200> result{};
+  for (std::size_t i = 0; i < 100; i++) {
+    result[2 * i] = static_cast<char>('0' + i / 10);
+    result[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return result;
+}();
+
+/// Writes 'value' in decimal right-aligned into the buffer ending at 'end' and
+/// returns a pointer to its first character. If 'width' is non-zero, exactly
+/// 'width' digits are written by padding with zeros.
+char* formatWord(std::uint64_t value, char* end, std::size_t width = 0) {
+  char* paddedStart = end - width;
+  while (value >= 100) {
+    end -= 2;
+    std::memcpy(end, &DIGIT_PAIRS[(value % 100) * 2], 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    end -= 2;
+    std::memcpy(end, &DIGIT_PAIRS[value * 2], 2);
+  } else {
+    *--end = static_cast<char>('0' + value);
+  }
+
+  if (width == 0)
+    return end;
+
+  std::fill(paddedStart, end, '0');
+  return paddedStart;
+}
+
+/// Converts the non-negative integer 'magnitude' to decimal one chunk at a
+/// time. Same semantics as 'formatWord' otherwise.
+char* formatChunked(pylir::BigInt magnitude, char* end, std::size_t width) {
+  char* start = end;
+  mp_int& handle = magnitude.getHandle();
+  while (!mp_iszero(&handle)) {
+    mp_digit remainder;
+    [[maybe_unused]] mp_err err =
+        mp_div_d(&handle, DECIMAL_CHUNK.base, &handle, &remainder);
+    PYLIR_ASSERT(err == MP_OKAY);
+    if (mp_iszero(&handle))
+      start = formatWord(remainder, start);
+    else
+      start = formatWord(remainder, start, DECIMAL_CHUNK.digits);
+  }
+
+  if (width == 0)
+    return start;
+
+  std::fill(end - width, start, '0');
+  return end - width;
+}
+
+/// Converts the non-negative integer 'magnitude' to decimal by splitting it at
+/// 'powers[level - 1]' and converting both halves recursively.
+/// 'powers[i]' is '10^(DECIMAL_CHUNK.digits * 2^i)'. Same semantics as
+/// 'formatWord' otherwise.
+char* formatRecursive(const pylir::BigInt& magnitude, char* end,
+                      std::size_t width,
+                      const std::vector<pylir::BigInt>& powers,
+                      std::size_t level) {
+  // Without padding, leading zeros must not be emitted. Skip any levels that
+  // would lead to the upper half being zero.
+  if (width == 0)
+    while (level > 0 && magnitude < powers[level - 1])
+      level--;
+
+  if (level == 0 || magnitude.getHandle().used <= DIVIDE_AND_CONQUER_THRESHOLD)
+    return formatChunked(magnitude, end, width);
+
+  std::size_t lowerDigits = DECIMAL_CHUNK.digits << (level - 1);
+  auto [upper, lower] = magnitude.divmod(powers[level - 1]);
+  formatRecursive(lower, end, lowerDigits, powers, level - 1);
+  return formatRecursive(upper, end - lowerDigits,
+                         width == 0 ? 0 : width - lowerDigits, powers,
+                         level - 1);
+}
+
 } // namespace
 
+std::size_t pylir::BigInt::decimalSizeOverestimate() const {
+  // 1234 / 4096 is slightly larger than log10(2). One character each is added
+  // for rounding and the sign.
+  auto bits = static_cast<std::size_t>(mp_count_bits(m_int));
+  return (bits * 1234 >> 12) + 2;
+}
+
+char* pylir::BigInt::toDecimal(char* end) const {
+  char* start;
+  if (mp_count_bits(m_int) <= std::numeric_limits<std::uint64_t>::digits) {
+    start = formatWord(mp_get_mag_u64(m_int), end);
+  } else {
+    BigInt magnitude;
+    cantFail(mp_abs(m_int, magnitude.m_int));
+    if (magnitude.m_int->used <= DIVIDE_AND_CONQUER_THRESHOLD) {
+      start = formatChunked(std::move(magnitude), end, 0);
+    } else {
+      std::vector<BigInt> powers{BigInt(DECIMAL_CHUNK.base)};
+      while (powers.back() <= magnitude)
+        powers.push_back(powers.back() * powers.back());
+      start = formatRecursive(magnitude, end, 0, powers, powers.size() - 1);
+    }
+  }
+
+  if (isNegative())
+    *--start = '-';
+  return start;
+}
+
+std::size_t pylir::BigInt::hash() const {
+  constexpr unsigned hashBits =
+      std::numeric_limits<std::size_t>::digits >= 64 ? 61 : 31;
+  constexpr std::size_t modulus = (std::size_t{1} << hashBits) - 1;
+
+  std::size_t result = 0;
+  for (int i = m_int->used - 1; i >= 0; i--) {
+    // Multiplying by a power of two modulo a mersenne prime is equal to
+    // rotating the bits within 'hashBits'.
+    for (unsigned shift = MP_DIGIT_BIT; shift != 0;) {
+      unsigned step = std::min(shift, hashBits - 1);
+      result = ((result << step) & modulus) | (result >> (hashBits - step));
+      shift -= step;
+    }
+    result += static_cast<std::size_t>(m_int->dp[i] % modulus);
+    if (result >= modulus)
+      result -= modulus;
+  }
+
+  if (isNegative())
+    result = -result;
+  // -1 is reserved as error value in CPython.
+  if (result == static_cast<std::size_t>(-1))
+    result = static_cast<std::size_t>(-2);
+  return result;
+}
+
 std::pair<pylir::BigInt, pylir::BigInt> pylir::toRatio(double value) {
   static_assert(std::numeric_limits<double>::radix == 2 &&
                 std::numeric_limits<double>::is_iec559);
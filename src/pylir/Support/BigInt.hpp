@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <optional>
@@ -177,6 +178,13 @@ public:
   }
 
   [[nodiscard]] std::string toString(std::uint8_t radix = 10) const {
+    if (radix == 10) {
+      std::string result(decimalSizeOverestimate(), '\0');
+      char* start = toDecimal(result.data() + result.size());
+      result.erase(0, start - result.data());
+      return result;
+    }
+
     std::size_t size;
     cantFail(mp_radix_size_overestimate(m_int, radix, &size));
     std::string result(size, '\0');
@@ -187,6 +195,21 @@ public:
     return result;
   }
 
+  /// Returns an upper bound of the amount of characters required to print this
+  /// integer in decimal, including its sign.
+  [[nodiscard]] std::size_t decimalSizeOverestimate() const;
+
+  /// Writes the decimal representation of this integer right-aligned into the
+  /// buffer ending at 'end' and returns a pointer to its first character. The
+  /// buffer must be at least 'decimalSizeOverestimate()' characters large.
+  char* toDecimal(char* end) const;
+
+  /// Returns the hash of this integer as defined by Python. This is the
+  /// absolute value of the integer modulo the mersenne prime '2^61 - 1'
+  /// ('2^31 - 1' on 32 bit platforms) with the sign of the integer applied.
+  /// A hash of -1 is turned into -2.
+  [[nodiscard]] std::size_t hash() const;
+
   [[nodiscard]] bool isZero() const {
     return mp_iszero(m_int);
   }
@@ -195,7 +218,7 @@ public:
     return mp_isneg(m_int);
   }
 
-  std::pair<BigInt, BigInt> divmod(const BigInt& rhs) {
+  std::pair<BigInt, BigInt> divmod(const BigInt& rhs) const {
     BigInt div;
     BigInt mod;
     cantFail(mp_div(m_int, rhs.m_int, div.m_int, mod.m_int));
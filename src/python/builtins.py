@@ -483,6 +483,9 @@ class int:
     def __bool__(self):
         return self != 0
 
+    def __hash__(self, /):
+        return pylir.intr.int.hash(self)
+
 
 @pylir.intr.const_export
 class bool(int):
@@ -601,15 +604,17 @@ def print(*objects, sep=None, end=None):
     # TODO: check sep & end are actually str if not None
     sep = " " if sep is None else sep
     end = "\n" if end is None else end
+    # Every piece is written directly into the runtime's output buffer instead
+    # of first concatenating them into a temporary string. The buffer makes
+    # sure the whole line is still emitted using a single write.
     i = 0
     tuple_len = len(objects)
-    res = ""
     while i < tuple_len:
         if i != 0:
-            res += sep
-        res += str(objects[i])
+            pylir.intr.intr.print(sep)
+        pylir.intr.intr.print(str(objects[i]))
         i += 1
-    pylir.intr.intr.print(res + end)
+    pylir.intr.intr.print(end)
 
 
 @pylir.intr.const_export
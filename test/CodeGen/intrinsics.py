@@ -24,6 +24,11 @@ t = pylir.intr.typeOf(foo)
 # CHECK: %[[BOOL:.*]] = py.bool_fromI1 %[[CMP]]
 pylir.intr.int.cmp("ne", 0, 1)
 
+# CHECK: %[[FIVE:.*]] = py.constant(#py.int<5>)
+# CHECK: %[[HASH:.*]] = py.int_hash %[[FIVE]]
+# CHECK: py.int_fromSigned %[[HASH]]
+pylir.intr.int.hash(5)
+
 # CHECK: %[[ZERO:.*]] = py.constant(#py.int<0>)
 # CHECK: %[[ONE:.*]] = py.constant(#py.int<1>)
 # CHECK: %[[TWO:.*]] = py.constant(#py.int<2>)
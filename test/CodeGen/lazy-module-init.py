@@ -0,0 +1,48 @@
+#  // Licensed under the Apache License v2.0 with LLVM Exceptions.
+#  // See https://llvm.org/LICENSE.txt for license information.
+#  // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+# RUN: split-file %s %t
+# RUN: pylir %t/main.py -flazy-module-init -Xno-builtins -S -emit-pylir -o - | FileCheck %s
+
+#--- main.py
+
+import foo
+import bar
+
+# CHECK-LABEL: init "__main__" {
+# CHECK: initModule @foo deferrable
+# CHECK: initModule @bar deferrable
+
+#--- bar.py
+
+# Observable effects at the top level require initialization at import.
+print(3)
+
+# CHECK-LABEL: init "bar" {
+
+# CHECK: globalFunc @bar.test{{.*}}(
+# CHECK-NOT: initModule
+# CHECK: return
+@pylir.intr.const_export
+def test():
+    return print
+
+#--- foo.py
+
+a = 3
+
+# CHECK-LABEL: init "foo" lazy {
+
+# CHECK: globalFunc @foo.test{{.*}}(
+# CHECK-NEXT: initModule @foo
+@pylir.intr.const_export
+def test():
+    return a
+
+# CHECK: globalFunc @foo.no_globals{{.*}}(
+# CHECK-NOT: initModule
+# CHECK: return
+@pylir.intr.const_export
+def no_globals(b):
+    return b
@@ -9,3 +9,21 @@ print(hash("text") == hash("text"))
 o = object()
 print(hash(o) == hash(o))
 # CHECK: True
+
+print(hash(5))
+# CHECK: 5
+print(hash(2305843009213693952))
+# CHECK: 1
+print(hash(2305843009213693951))
+# CHECK: 0
+print(hash(True))
+# CHECK: 1
+
+print(hash(-5))
+# CHECK: -5
+print(hash(-1))
+# CHECK: -2
+print(hash(-2305843009213693952))
+# CHECK: -2
+print(hash(-2305843009213693954))
+# CHECK: -3
@@ -0,0 +1,17 @@
+# RUN: split-file %s %t
+# RUN: pylir %t/main.py -o %t/main
+# RUN: %t/main | FileCheck %s --match-full-lines
+
+#--- main.py
+
+import foo
+import foo
+
+print("main")
+
+# CHECK: foo
+# CHECK-NEXT: main
+
+#--- foo.py
+
+print("foo")
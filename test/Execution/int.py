@@ -16,3 +16,9 @@ if 1:
 
 print(5 + 7)
 # CHECK: 12
+
+print(123456789012345678901234567890)
+# CHECK: 123456789012345678901234567890
+
+print(str(-18446744073709551616))
+# CHECK: -18446744073709551616
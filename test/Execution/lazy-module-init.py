@@ -0,0 +1,18 @@
+# RUN: split-file %s %t
+# RUN: pylir %t/main.py -flazy-module-init -o %t/main
+# RUN: %t/main | FileCheck %s --match-full-lines
+
+#--- main.py
+
+import foo
+import foo
+
+print("main")
+
+# Top-level effects of a module must still happen at import.
+# CHECK: foo
+# CHECK-NEXT: main
+
+#--- foo.py
+
+print("foo")
@@ -0,0 +1,9 @@
+# RUN: pylir %s -o %t
+# RUN: not %t 2>&1 | FileCheck %s
+
+# Output buffered by print must be written before the message of an uncaught
+# exception.
+print("before")
+raise TypeError
+# CHECK: before
+# CHECK-NEXT: TypeError:
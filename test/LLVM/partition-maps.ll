@@ -0,0 +1,25 @@
+; RUN: pylir %s -S -o - | FileCheck %s
+
+; REQUIRES: x86-registered-target
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+@a = constant i32 0, section "py_root"
+
+define void @dummy() gc "pylir-gc" {
+    ret void
+}
+
+!pylir.gc.partition = !{!0}
+!0 = !{i32 2}
+
+; Partitions emit their stack map under a unique name. The global maps are
+; created prior to splitting the module.
+
+; CHECK-NOT: pylir_roots_start
+; CHECK: .globl pylir_stack_map$2
+; CHECK-LABEL: pylir_stack_map$2:
+; Magic PYLR
+; CHECK-NEXT: .long 1348029522
+; CHECK-NOT: pylir_roots_start
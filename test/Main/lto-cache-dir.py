@@ -0,0 +1,8 @@
+# RUN: pylir %s -flto=thin --cache-dir=cache -o test --sysroot=%S/Inputs/fedora-sysroot --target=x86_64-unknown-linux-gnu -### 2>&1 | FileCheck %s --check-prefix=GNU
+# RUN: pylir %s -flto=thin --cache-dir=cache -o test --target=x86_64-w64-windows-gnu -### 2>&1 | FileCheck %s --check-prefix=GNU
+# RUN: pylir %s -flto=thin --cache-dir=cache -o test --target=x86_64-pc-windows-msvc -### 2>&1 | FileCheck %s --check-prefix=MSVC
+# RUN: pylir %s -flto=thin --cache-dir=cache -o test --target=x86_64-apple-darwin -### 2>&1 | FileCheck %s --check-prefix=MAC
+
+# GNU: --thinlto-cache-dir=cache{{/|\\}}lto
+# MSVC: /lldltocache:cache{{/|\\}}lto
+# MAC: -cache_path_lto cache{{/|\\}}lto
@@ -2,6 +2,7 @@
 # RUN: pylir %s -O4 -c -o %t 2>&1 | FileCheck %s --check-prefixes=OBJECT,CHECK
 # RUN: pylir %s -flto -S -o %t 2>&1 | FileCheck %s --check-prefixes=LTO_ASSEMBLY,CHECK
 # RUN: pylir %s -flto -c -o %t 2>&1 | FileCheck %s --check-prefixes=LTO_OBJECT,CHECK
+# RUN: pylir %s -flto=thin -c -o %t 2>&1 | FileCheck %s --check-prefixes=LTO_OBJECT,CHECK
 
 # CHECK-COUNT-1: warning
 # ASSEMBLY: LTO. Compiler might output LLVM IR instead of an Assembly file
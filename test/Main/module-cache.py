@@ -0,0 +1,33 @@
+# RUN: rm -rf %t && split-file %s %t
+# RUN: pylir %t/main.py -S -emit-pylir -o %t/first.mlir --cache-dir=%t/cache
+# RUN: ls %t/cache | FileCheck %s --check-prefix=CACHE
+# RUN: pylir %t/main.py -S -emit-pylir -o %t/second.mlir --cache-dir=%t/cache
+# RUN: diff %t/first.mlir %t/second.mlir
+
+# Imports of cached modules must still be compiled and part of the depfile.
+# RUN: pylir %t/main.py -emit-pylir -o %t/main.exe -M - --cache-dir=%t/cache \
+# RUN:   | FileCheck %s --check-prefix=DEPS
+
+# Changing the source of a module invalidates its cache entry.
+# RUN: echo "value = 5" >> %t/foo/__init__.py
+# RUN: pylir %t/main.py -S -emit-pylir -o - --cache-dir=%t/cache \
+# RUN:   | FileCheck %s --check-prefix=CHANGED
+
+#--- main.py
+
+import foo.bar
+
+#--- foo/__init__.py
+
+#--- foo/bar.py
+
+print(True)
+
+# CACHE: .mlirbc
+
+# DEPS: main.exe:
+# DEPS-DAG: builtins.py
+# DEPS-DAG: foo{{/|\\}}__init__.py
+# DEPS-DAG: foo{{/|\\}}bar.py
+
+# CHANGED: #py.int<5>
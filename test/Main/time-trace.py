@@ -0,0 +1,27 @@
+# REQUIRES: x86-registered-target
+
+# RUN: rm -rf %t && mkdir -p %t
+# RUN: pylir %s --target=x86_64-unknown-linux-gnu -c -o %t/out.o -ftime-trace
+# RUN: FileCheck %s --input-file=%t/out.json --check-prefix=DEFAULT
+# RUN: pylir %s --target=x86_64-unknown-linux-gnu -c -o %t/out.o \
+# RUN:   -ftime-trace=%t/explicit.json -ftime-trace-granularity=0
+# RUN: FileCheck %s --input-file=%t/explicit.json
+
+# DEFAULT: "traceEvents"
+# DEFAULT: "name":"ExecuteCompiler"
+
+# Phases shorter than the granularity are omitted from the trace.
+# CHECK: "traceEvents"
+# CHECK-DAG: "name":"ExecuteCompiler"
+# CHECK-DAG: "name":"Parse"
+# CHECK-DAG: "name":"SemanticAnalysis"
+# CHECK-DAG: "name":"CodeGen Module"
+# CHECK-DAG: "name":"MLIR Pipeline"
+# CHECK-DAG: "name":"Translate to LLVM IR"
+# CHECK-DAG: "name":"LLVM Pipeline"
+
+# RUN: not pylir %s -c -o %t/out.o -ftime-trace-granularity=abc 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=INVALID
+# INVALID: invalid time trace granularity 'abc'
+
+print("Hello")
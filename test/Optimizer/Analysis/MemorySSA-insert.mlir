@@ -0,0 +1,78 @@
+// RUN: pylir-opt %s --test-memory-ssa='reinsert-op=py.list_resize' --split-input-file | FileCheck %s --check-prefix=DEF
+// RUN: pylir-opt %s --test-memory-ssa='reinsert-op=py.list_len' --split-input-file | FileCheck %s --check-prefix=USE
+
+py.func @test(%length : index) -> index {
+    %1 = makeList ()
+    list_resize %1 to %length
+    %2 = list_len %1
+    return %2 : index
+}
+
+// DEF-LABEL: memSSA.module
+// DEF-NEXT: %[[LIVE_ON_ENTRY:.*]] = liveOnEntry
+// DEF-NEXT: %[[DEF_OBJECT:.*]] = def(%[[LIVE_ON_ENTRY]])
+// DEF-NEXT: // {{.*}} py.makeList
+// DEF-NEXT: %[[DEF_LIST:.*]] = def(%[[LIVE_ON_ENTRY]])
+// DEF-NEXT: // {{.*}} py.makeList
+// DEF-NEXT: %[[RESIZE:.*]] = def(%[[DEF_LIST]])
+// DEF-NEXT: // py.list_resize
+// DEF-NEXT: use(%[[RESIZE]])
+// DEF-NEXT: // {{.*}} py.list_len
+
+// USE-LABEL: memSSA.module
+// USE-NEXT: %[[LIVE_ON_ENTRY:.*]] = liveOnEntry
+// USE-NEXT: %[[DEF_OBJECT:.*]] = def(%[[LIVE_ON_ENTRY]])
+// USE-NEXT: // {{.*}} py.makeList
+// USE-NEXT: %[[DEF_LIST:.*]] = def(%[[LIVE_ON_ENTRY]])
+// USE-NEXT: // {{.*}} py.makeList
+// USE-NEXT: %[[RESIZE:.*]] = def(%[[DEF_LIST]])
+// USE-NEXT: // py.list_resize
+// USE-NEXT: use(%[[RESIZE]])
+// USE-NEXT: // {{.*}} py.list_len
+
+py.func @test2(%arg0 : i1, %length : index) -> index {
+    %1 = makeList ()
+    cf.cond_br %arg0, ^bb1, ^bb2
+
+^bb1:
+    list_resize %1 to %length
+    cf.br ^bb2
+
+^bb2:
+    %2 = list_len %1
+    return %2 : index
+}
+
+// Only the branch dominated by the new def is changed to use it.
+
+// DEF-LABEL: memSSA.module
+// DEF-NEXT: %[[LIVE_ON_ENTRY:.*]] = liveOnEntry
+// DEF-NEXT: %[[DEF_OBJECT:.*]] = def(%[[LIVE_ON_ENTRY]])
+// DEF-NEXT: // {{.*}} py.makeList
+// DEF-NEXT: %[[DEF_LIST:.*]] = def(%[[LIVE_ON_ENTRY]])
+// DEF-NEXT: // {{.*}} py.makeList
+// DEF-NEXT: br ^[[FIRST:.*]], ^[[SECOND:.*]] (), (%[[DEF_LIST]])
+// DEF-NEXT: ^[[FIRST]]:
+// DEF-NEXT: %[[RESIZE:.*]] = def(%[[DEF_LIST]])
+// DEF-NEXT: // py.list_resize
+// DEF-NEXT: br ^[[SECOND]] (%[[RESIZE]])
+// DEF-NEXT: ^[[SECOND]]
+// DEF-SAME: %[[MERGE:[[:alnum:]]+]]
+// DEF-NEXT: use(%[[MERGE]])
+// DEF-NEXT: // {{.*}} py.list_len
+
+// USE-LABEL: memSSA.module
+// USE-NEXT: %[[LIVE_ON_ENTRY:.*]] = liveOnEntry
+// USE-NEXT: %[[DEF_OBJECT:.*]] = def(%[[LIVE_ON_ENTRY]])
+// USE-NEXT: // {{.*}} py.makeList
+// USE-NEXT: %[[DEF_LIST:.*]] = def(%[[LIVE_ON_ENTRY]])
+// USE-NEXT: // {{.*}} py.makeList
+// USE-NEXT: br ^[[FIRST:.*]], ^[[SECOND:.*]] (), (%[[DEF_LIST]])
+// USE-NEXT: ^[[FIRST]]:
+// USE-NEXT: %[[RESIZE:.*]] = def(%[[DEF_LIST]])
+// USE-NEXT: // py.list_resize
+// USE-NEXT: br ^[[SECOND]] (%[[RESIZE]])
+// USE-NEXT: ^[[SECOND]]
+// USE-SAME: %[[MERGE:[[:alnum:]]+]]
+// USE-NEXT: use(%[[MERGE]])
+// USE-NEXT: // {{.*}} py.list_len
@@ -0,0 +1,44 @@
+// RUN: pylir-opt %s --test-memory-ssa='remove-op=py.list_resize' --split-input-file | FileCheck %s
+
+py.func @test(%length : index) -> index {
+    %1 = makeList ()
+    list_resize %1 to %length
+    %2 = list_len %1
+    return %2 : index
+}
+
+// CHECK-LABEL: memSSA.module
+// CHECK-NEXT: %[[LIVE_ON_ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF_OBJECT:.*]] = def(%[[LIVE_ON_ENTRY]])
+// CHECK-NEXT: // {{.*}} py.makeList
+// CHECK-NEXT: %[[DEF_LIST:.*]] = def(%[[LIVE_ON_ENTRY]])
+// CHECK-NEXT: // {{.*}} py.makeList
+// CHECK-NEXT: use(%[[DEF_LIST]])
+// CHECK-NEXT: // {{.*}} py.list_len
+
+py.func @test2(%arg0 : i1, %length : index) -> index {
+    %1 = makeList ()
+    cf.cond_br %arg0, ^bb1, ^bb2
+
+^bb1:
+    list_resize %1 to %length
+    cf.br ^bb2
+
+^bb2:
+    %2 = list_len %1
+    return %2 : index
+}
+
+// CHECK-LABEL: memSSA.module
+// CHECK-NEXT: %[[LIVE_ON_ENTRY:.*]] = liveOnEntry
+// CHECK-NEXT: %[[DEF_OBJECT:.*]] = def(%[[LIVE_ON_ENTRY]])
+// CHECK-NEXT: // {{.*}} py.makeList
+// CHECK-NEXT: %[[DEF_LIST:.*]] = def(%[[LIVE_ON_ENTRY]])
+// CHECK-NEXT: // {{.*}} py.makeList
+// CHECK-NEXT: br ^[[FIRST:.*]], ^[[SECOND:.*]] (), (%[[DEF_LIST]])
+// CHECK-NEXT: ^[[FIRST]]:
+// CHECK-NEXT: br ^[[SECOND]] (%[[DEF_LIST]])
+// CHECK-NEXT: ^[[SECOND]]
+// CHECK-SAME: %[[MERGE:[[:alnum:]]+]]
+// CHECK-NEXT: use(%[[MERGE]])
+// CHECK-NEXT: // {{.*}} py.list_len
@@ -1,14 +1,50 @@
 // RUN: pylir-opt %s --convert-pylirHIR-to-pylirPy --split-input-file | FileCheck %s
 
 // CHECK-LABEL: py.func @foo.__init__()
+// CHECK-NEXT: %[[INITIALIZED:.*]] = load @foo.__init__$initialized : index
+// CHECK-NEXT: %[[ZERO:.*]] = arith.constant 0
+// CHECK-NEXT: %[[CMP:.*]] = arith.cmpi ne, %[[INITIALIZED]], %[[ZERO]]
+// CHECK-NEXT: cf.cond_br %[[CMP]], ^[[RETURN:[[:alnum:]]+]], ^[[MARK:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[MARK]]:
+// CHECK-NEXT: %[[ONE:.*]] = arith.constant 1
+// CHECK-NEXT: store %[[ONE]] : index into @foo.__init__$initialized
+// CHECK-NEXT: cf.br ^[[BODY:[[:alnum:]]+]]
+// CHECK-NEXT: ^[[RETURN]]:
+// CHECK-NEXT: return
+// CHECK-NEXT: ^[[BODY]]:
+// CHECK-NEXT: return
+
+// CHECK: py.global "private" @foo.__init__$initialized : index = 0 : index
 pyHIR.init "foo" {
-  // CHECK-NEXT: return
   init_return
 }
 
 // CHECK-LABEL: py.func @__init__()
+// CHECK-NOT: load
 pyHIR.init "__main__" {
   // CHECK: call @foo.__init__() : () -> ()
   initModule @foo
   init_return
 }
+
+// -----
+
+pyHIR.init "lazy" lazy {
+  init_return
+}
+
+pyHIR.init "eager" {
+  init_return
+}
+
+// CHECK-LABEL: py.func @__init__()
+// CHECK-NOT: call @lazy.__init__
+// CHECK: call @eager.__init__() : () -> ()
+// CHECK-NEXT: call @lazy.__init__() : () -> ()
+// CHECK-NEXT: return
+pyHIR.init "__main__" {
+  initModule @lazy deferrable
+  initModule @eager deferrable
+  initModule @lazy
+  init_return
+}
@@ -0,0 +1,47 @@
+// RUN: pylir-opt %s -convert-arith-to-llvm -convert-pylir-to-llvm --reconcile-unrealized-casts --split-input-file | FileCheck %s
+
+#builtins_type = #py.globalValue<builtins.type, initializer = #py.type>
+py.external @builtins.type, #builtins_type
+#builtins_tuple = #py.globalValue<builtins.tuple, initializer = #py.type>
+py.external @builtins.tuple, #builtins_tuple
+#builtins_BaseException = #py.globalValue<builtins.BaseException, initializer = #py.type>
+py.external @builtins.BaseException, #builtins_BaseException
+#builtins_StopIteration = #py.globalValue<builtins.StopIteration, initializer = #py.type<mro_tuple = #py.tuple<(#py.globalValue<builtins.StopIteration>, #builtins_BaseException)>>>
+py.external @builtins.StopIteration, #builtins_StopIteration
+
+py.func @alloc() -> !pyMem.memory {
+  %0 = constant(#builtins_StopIteration)
+  %c0 = arith.constant 0 : index
+  %1 = pyMem.gcAllocObject %0[%c0]
+  return %1 : !pyMem.memory
+}
+
+// CHECK-LABEL: llvm.func @alloc
+// CHECK: %[[TYPE:.*]] = llvm.mlir.addressof @builtins.StopIteration
+// CHECK: %[[BYTES:.*]] = llvm.add
+// CHECK-NEXT: %[[MEMORY:.*]] = llvm.call @pylir_exception_alloc(%[[TYPE]], %[[BYTES]])
+// CHECK-NEXT: %[[ZERO_I8:.*]] = llvm.mlir.constant(0 : i8)
+// CHECK-NEXT: "llvm.intr.memset"(%[[MEMORY]], %[[ZERO_I8]], %[[BYTES]])
+
+// -----
+
+py.func @raise_pooled(%arg0 : !py.dynamic) {
+  raise %arg0 {py.pooled}
+}
+
+// CHECK-LABEL: llvm.func @raise_pooled
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: llvm.call @pylir_raise_pooled(%[[ARG0]])
+// CHECK-NEXT: llvm.unreachable
+
+// -----
+
+py.func @release(%arg0 : !py.dynamic) {
+  releaseException %arg0
+  return
+}
+
+// CHECK-LABEL: llvm.func @release
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: llvm.call @pylir_exception_release(%[[ARG0]])
+// CHECK-NEXT: llvm.return
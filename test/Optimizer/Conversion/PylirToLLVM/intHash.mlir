@@ -0,0 +1,22 @@
+// RUN: pylir-opt %s -convert-pylir-to-llvm --reconcile-unrealized-casts --split-input-file | FileCheck %s
+
+#builtins_type = #py.globalValue<builtins.type, initializer = #py.type>
+py.external @builtins.type, #builtins_type
+#builtins_int = #py.globalValue<builtins.int, initializer = #py.type>
+py.external @builtins.int, #builtins_int
+#builtins_str = #py.globalValue<builtins.str, initializer = #py.type>
+py.external @builtins.str, #builtins_str
+#builtins_tuple = #py.globalValue<builtins.tuple, initializer = #py.type>
+py.external @builtins.tuple, #builtins_tuple
+
+py.func @foo(%arg0 : !py.dynamic) -> index {
+    %0 = int_hash %arg0
+    return %0 : index
+}
+
+// CHECK-LABEL: @foo
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: %[[HASH:.*]] = llvm.call @pylir_int_hash(%[[ARG0]])
+// CHECK-NEXT: llvm.return %[[HASH]]
+
+// CHECK: llvm.func @pylir_int_hash
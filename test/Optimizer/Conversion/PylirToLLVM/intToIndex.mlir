@@ -17,3 +17,18 @@ py.func @foo(%value : !py.dynamic) -> index {
 // CHECK: %[[GEP:.*]] = llvm.getelementptr %[[VALUE]][0, 1]
 // CHECK: %[[RES:.*]] = llvm.call @mp_get_i64(%[[GEP]])
 // CHECK: llvm.return %[[RES]]
+
+py.func @bar(%value : !py.dynamic) -> (index, i1) {
+    %0, %1 = int_tryToIndex %value
+    return %0, %1 : index, i1
+}
+
+// CHECK-LABEL: llvm.func @bar
+// CHECK-SAME: %[[VALUE:[[:alnum:]]+]]
+// CHECK: %[[GEP:.*]] = llvm.getelementptr %[[VALUE]][0, 1]
+// CHECK: %[[BITS:.*]] = llvm.call @mp_count_bits(%[[GEP]])
+// CHECK: %[[WIDTH:.*]] = llvm.mlir.constant(64 : i{{.*}})
+// CHECK: %[[VALID:.*]] = llvm.icmp "slt" %[[BITS]], %[[WIDTH]]
+// CHECK: %[[RES:.*]] = llvm.call @mp_get_i64(%[[GEP]])
+// CHECK: llvm.insertvalue %[[RES]]
+// CHECK: llvm.insertvalue %[[VALID]]
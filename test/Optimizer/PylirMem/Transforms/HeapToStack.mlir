@@ -46,3 +46,23 @@ py.func @too_large() {
 // CHECK: %[[C:.*]] = arith.constant 128
 // CHECK: %[[T:.*]] = constant(#[[$TUPLE]])
 // CHECK: pyMem.gcAllocObject %[[T]][%[[C]]]
+
+py.func private @no_capture(!py.dynamic)
+
+py.func @call_no_capture() {
+    %c0 = arith.constant 0 : index
+    %t = constant(#builtins_tuple)
+    %m0 = pyMem.gcAllocObject %t[%c0]
+    %0 = pyMem.initTuple %m0 to ()
+    call @no_capture(%0) {py.no_capture_operands = array<i32: 0>} : (!py.dynamic) -> ()
+    %m1 = pyMem.gcAllocObject %t[%c0]
+    %1 = pyMem.initTuple %m1 to ()
+    call @no_capture(%1) : (!py.dynamic) -> ()
+    return
+}
+
+// CHECK-LABEL: @call_no_capture
+// CHECK: %[[C:.*]] = arith.constant 0
+// CHECK: %[[T:.*]] = constant(#[[$TUPLE]])
+// CHECK: pyMem.stackAllocObject tuple %[[T]][0]
+// CHECK: pyMem.gcAllocObject %[[T]][%[[C]]]
@@ -51,3 +51,29 @@ py.func @test5() -> (index, index) {
 }
 
 // CHECK-LABEL: @test5
+
+py.func @test6(%arg0 : index) -> (index, i1) {
+    %0 = int_fromSigned %arg0
+    %1, %2 = int_tryToIndex %0
+    return %1, %2 : index, i1
+}
+
+// CHECK-LABEL: @test6
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[TRUE:.*]] = arith.constant true
+// CHECK: return %[[ARG0]], %[[TRUE]]
+
+py.func @test7() -> (index, i1, index, i1) {
+    %0 = constant(#py.int<-5>)
+    %1 = constant(#py.int<523298231467239746239754623792364923764239476239472364>)
+    %2, %3 = int_tryToIndex %0
+    %4, %5 = int_tryToIndex %1
+    return %2, %3, %4, %5 : index, i1, index, i1
+}
+
+// CHECK-LABEL: @test7
+// CHECK-DAG: %[[C1:.*]] = arith.constant -5
+// CHECK-DAG: %[[C2:.*]] = arith.constant 0
+// CHECK-DAG: %[[TRUE:.*]] = arith.constant true
+// CHECK-DAG: %[[FALSE:.*]] = arith.constant false
+// CHECK: return %[[C1]], %[[TRUE]], %[[C2]], %[[FALSE]]
@@ -0,0 +1,71 @@
+// RUN: pylir-opt %s --pylir-escape-summary --split-input-file | FileCheck %s
+
+py.global @g : !py.dynamic
+
+// CHECK-LABEL: py.func private @reads(
+// CHECK-SAME: py.no_capture
+py.func private @reads(%arg0 : !py.dynamic) -> !py.dynamic {
+  %0 = typeOf %arg0
+  return %0 : !py.dynamic
+}
+
+// CHECK-LABEL: py.func private @stores(
+// CHECK-NOT: py.no_capture
+// CHECK-SAME: {
+py.func private @stores(%arg0 : !py.dynamic) {
+  store %arg0 : !py.dynamic into @g
+  return
+}
+
+// CHECK-LABEL: py.func private @returns(
+// CHECK-NOT: py.no_capture
+// CHECK-SAME: {
+py.func private @returns(%arg0 : !py.dynamic) -> !py.dynamic {
+  return %arg0 : !py.dynamic
+}
+
+// Captures through callees are propagated to the callers.
+
+// CHECK-LABEL: py.func @caller(
+// CHECK-SAME: %{{[[:alnum:]]+}}: !py.dynamic {py.no_capture}
+// CHECK-SAME: %{{[[:alnum:]]+}}: !py.dynamic
+// CHECK-NOT: py.no_capture
+// CHECK-SAME: {
+py.func @caller(%arg0 : !py.dynamic, %arg1 : !py.dynamic) -> !py.dynamic {
+  // CHECK: call @reads(%{{.*}}) {py.no_capture_operands = array<i32: 0>}
+  %0 = call @reads(%arg0) : (!py.dynamic) -> !py.dynamic
+  // CHECK: call @stores(%{{.*}}) :
+  call @stores(%arg1) : (!py.dynamic) -> ()
+  return %0 : !py.dynamic
+}
+
+// -----
+
+// Recursive functions optimistically assume their arguments are not captured.
+
+// CHECK-LABEL: py.func private @recursive(
+// CHECK-SAME: py.no_capture
+py.func private @recursive(%arg0 : !py.dynamic, %arg1 : i1) {
+  cf.cond_br %arg1, ^bb1, ^bb2
+
+^bb1:
+  %0 = arith.constant false
+  call @recursive(%arg0, %0) : (!py.dynamic, i1) -> ()
+  cf.br ^bb2
+
+^bb2:
+  return
+}
+
+// -----
+
+py.func private @unknown(!py.dynamic)
+
+// CHECK-LABEL: py.func @external_callee(
+// CHECK-NOT: py.no_capture
+// CHECK-SAME: {
+py.func @external_callee(%arg0 : !py.dynamic) {
+  // CHECK: call @unknown(%{{.*}}) :
+  call @unknown(%arg0) : (!py.dynamic) -> ()
+  return
+}
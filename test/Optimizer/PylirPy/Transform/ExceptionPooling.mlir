@@ -0,0 +1,120 @@
+// RUN: pylir-opt %s --pylir-exception-pooling --split-input-file | FileCheck %s
+
+#builtins_StopIteration = #py.globalValue<builtins.StopIteration>
+
+// CHECK-LABEL: py.func @fresh
+py.func @fresh(%arg0 : !py.dynamic) {
+  %0 = constant(#builtins_StopIteration)
+  %1 = makeObject %0
+  %c0 = arith.constant 0 : index
+  setSlot %1[%c0] to %arg0
+  // CHECK: raise %{{.*}} {py.pooled}
+  raise %1
+}
+
+// CHECK-LABEL: py.func @argument
+py.func @argument(%arg0 : !py.dynamic) {
+  // CHECK: raise %{{.*}}
+  // CHECK-NOT: py.pooled
+  raise %arg0
+}
+
+// -----
+
+#builtins_StopIteration = #py.globalValue<builtins.StopIteration>
+
+py.global "private" @last : !py.dynamic
+
+// CHECK-LABEL: py.func @captured
+py.func @captured() {
+  %0 = constant(#builtins_StopIteration)
+  %1 = makeObject %0
+  store %1 : !py.dynamic into @last
+  // CHECK: raise %{{.*}}
+  // CHECK-NOT: py.pooled
+  raise %1
+}
+
+// -----
+
+#builtins_StopIteration = #py.globalValue<builtins.StopIteration>
+
+py.func private @next() -> !py.dynamic
+
+// CHECK-LABEL: py.func @handler
+py.func @handler() -> !py.dynamic {
+  %0 = invoke @next() : () -> !py.dynamic
+    label ^bb1 unwind ^bb2
+
+^bb1:
+  return %0 : !py.dynamic
+
+// CHECK: ^[[HANDLER:.*]](%[[E:.*]]: !py.dynamic):
+// CHECK-NEXT: typeOf %[[E]]
+^bb2(%e : !py.dynamic):
+  %1 = typeOf %e
+  %2 = constant(#builtins_StopIteration)
+  %3 = is %1, %2
+  cf.cond_br %3, ^bb3, ^bb4
+
+// CHECK: ^{{.*}}:
+// CHECK-NEXT: releaseException %[[E]]
+// CHECK-NEXT: %[[NONE:.*]] = constant
+// CHECK-NEXT: return %[[NONE]]
+^bb3:
+  %4 = constant(#py.globalValue<builtins.None>)
+  return %4 : !py.dynamic
+
+// CHECK: ^{{.*}}:
+// CHECK-NEXT: raise %[[E]]
+^bb4:
+  raise %e
+}
+
+// -----
+
+py.global "private" @last : !py.dynamic
+
+py.func private @next() -> !py.dynamic
+
+// CHECK-LABEL: py.func @retaining_handler
+py.func @retaining_handler() -> !py.dynamic {
+  %0 = invoke @next() : () -> !py.dynamic
+    label ^bb1 unwind ^bb2
+
+^bb1:
+  return %0 : !py.dynamic
+
+^bb2(%e : !py.dynamic):
+  store %e : !py.dynamic into @last
+  return %e : !py.dynamic
+}
+
+// CHECK-NOT: releaseException
+
+// -----
+
+#builtins_StopIteration = #py.globalValue<builtins.StopIteration>
+
+py.func private @next() -> !py.dynamic
+
+// CHECK-LABEL: py.func @raise_ex_handler
+py.func @raise_ex_handler(%arg0 : !py.dynamic) -> !py.dynamic {
+  %0 = invoke @next() : () -> !py.dynamic
+    label ^bb1 unwind ^bb3
+
+^bb1:
+  raiseEx %arg0
+    label ^bb2 unwind ^bb3
+
+^bb2:
+  return %0 : !py.dynamic
+
+^bb3(%e : !py.dynamic):
+  %1 = constant(#builtins_StopIteration)
+  return %1 : !py.dynamic
+}
+
+// The exception object passed by 'raiseEx' may be retained elsewhere.
+
+// CHECK-NOT: releaseException
@@ -0,0 +1,80 @@
+// RUN: pylir-opt %s --pylir-function-specialization --canonicalize --split-input-file | FileCheck %s
+
+py.func @dispatch(%arg0 : !py.dynamic) -> !py.dynamic {
+  %0 = typeOf %arg0
+  return %0 : !py.dynamic
+}
+
+// CHECK-LABEL: py.func @dispatch(
+// CHECK-NEXT: %[[TYPE:.*]] = typeOf
+// CHECK-NEXT: return %[[TYPE]]
+
+// CHECK-LABEL: py.func private @dispatch$spec_0(
+// CHECK-SAME: py.type = #[[$STR:[[:alnum:]_]+]]
+// CHECK-NEXT: %[[TYPE:.*]] = constant(#[[$STR]])
+// CHECK-NEXT: return %[[TYPE]]
+
+// CHECK-LABEL: py.func private @dispatch$spec(
+// CHECK-SAME: py.type = #[[$INT:[[:alnum:]_]+]]
+// CHECK-NEXT: %[[TYPE:.*]] = constant(#[[$INT]])
+// CHECK-NEXT: return %[[TYPE]]
+
+// CHECK-LABEL: py.func @caller
+py.func @caller(%arg0 : !py.dynamic) -> !py.dynamic {
+  %0 = constant(#py.int<5>)
+  %1 = constant(#py.str<"text">)
+  // CHECK: call @dispatch$spec(
+  %2 = call @dispatch(%0) : (!py.dynamic) -> !py.dynamic
+  // CHECK: call @dispatch$spec_0(
+  %3 = call @dispatch(%1) : (!py.dynamic) -> !py.dynamic
+  // CHECK: call @dispatch(
+  %4 = call @dispatch(%arg0) : (!py.dynamic) -> !py.dynamic
+  %5 = makeTuple (%2, %3, %4)
+  return %5 : !py.dynamic
+}
+
+// -----
+
+// Private functions only called directly have the types all call sites agree
+// on attached in place.
+
+// CHECK-LABEL: py.func private @agreed(
+// CHECK-SAME: py.type = #[[$INT:[[:alnum:]_]+]]
+// CHECK-NEXT: %[[TYPE:.*]] = constant(#[[$INT]])
+// CHECK-NEXT: return %[[TYPE]]
+py.func private @agreed(%arg0 : !py.dynamic) -> !py.dynamic {
+  %0 = typeOf %arg0
+  return %0 : !py.dynamic
+}
+
+// CHECK-NOT: $spec
+
+// CHECK-LABEL: py.func @caller
+py.func @caller() -> !py.dynamic {
+  %0 = constant(#py.int<5>)
+  %1 = constant(#py.int<3>)
+  %2 = call @agreed(%0) : (!py.dynamic) -> !py.dynamic
+  %3 = call @agreed(%1) : (!py.dynamic) -> !py.dynamic
+  %4 = makeTuple (%2, %3)
+  return %4 : !py.dynamic
+}
+
+// -----
+
+// The types of returned values are attached to the call sites.
+
+py.func @make() -> !py.dynamic {
+  %0 = makeList ()
+  return %0 : !py.dynamic
+}
+
+// CHECK-LABEL: py.func @caller
+// CHECK-NEXT: %[[LIST:.*]] = constant(#{{.*}}list{{.*}})
+// CHECK-NEXT: call @make()
+// CHECK-SAME: py.result_types
+// CHECK-NEXT: return %[[LIST]]
+py.func @caller() -> !py.dynamic {
+  %0 = call @make() : () -> !py.dynamic
+  %1 = typeOf %0
+  return %1 : !py.dynamic
+}
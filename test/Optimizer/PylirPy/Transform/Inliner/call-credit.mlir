@@ -0,0 +1,42 @@
+// RUN: pylir-opt %s --pylir-inliner='threshold=0 optimization-pipeline=any(canonicalize)' --split-input-file | FileCheck %s
+
+// The cost of the call being replaced is credited towards the threshold.
+// Wrappers that are no more expensive than the call to them are therefore
+// inlined, even with a threshold of zero.
+
+py.func private @external(%arg0 : i32) -> i32
+
+py.func @wrapper(%arg0 : i32) -> i32 {
+    %0 = call @external(%arg0) : (i32) -> i32
+    return %0 : i32
+}
+
+py.func @test(%arg0 : i32) -> i32 {
+    %0 = call @wrapper(%arg0) : (i32) -> i32
+    return %0 : i32
+}
+
+// CHECK-LABEL: py.func @test
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: %[[VALUE:.*]] = call @external(%[[ARG0]])
+// CHECK-NEXT: return %[[VALUE]]
+
+// -----
+
+py.func private @external(%arg0 : i32) -> i32
+
+py.func @wrapper(%arg0 : i32) -> i32 {
+    %0 = arith.muli %arg0, %arg0 : i32
+    %1 = call @external(%0) : (i32) -> i32
+    return %1 : i32
+}
+
+py.func @test(%arg0 : i32) -> i32 {
+    %0 = call @wrapper(%arg0) : (i32) -> i32
+    return %0 : i32
+}
+
+// CHECK-LABEL: py.func @test
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: %[[VALUE:.*]] = call @wrapper(%[[ARG0]])
+// CHECK-NEXT: return %[[VALUE]]
@@ -0,0 +1,21 @@
+// RUN: pylir-opt %s --pylir-inliner='optimization-pipeline=any(any(test-hello-world)) function-pipeline=any(test-hello-world) max-inlining-iterations=1' | FileCheck %s
+
+// The optimization pipeline runs once on each of the three functions prior to
+// inlining. After inlining 'foo' into 'main', only 'main' is optimized using
+// the function pipeline. The optimization pipeline runs on all functions once
+// more at the very end.
+// CHECK-COUNT-7: Hello World!
+// CHECK-NOT: Hello World!
+
+py.func @foo() {
+    return
+}
+
+py.func @main() {
+    call @foo() : () -> ()
+    return
+}
+
+py.func @unrelated() {
+    return
+}
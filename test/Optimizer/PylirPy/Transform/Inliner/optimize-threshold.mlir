@@ -0,0 +1,27 @@
+// RUN: pylir-opt %s -pass-pipeline='builtin.module(pylir-optimize{inliner-threshold=0})' -mlir-pass-statistics 2>&1 | FileCheck %s --check-prefix=NONE
+// RUN: pylir-opt %s -pass-pipeline='builtin.module(pylir-optimize{inliner-threshold=100})' -mlir-pass-statistics 2>&1 | FileCheck %s --check-prefix=INLINE
+
+// The threshold of the inliner within 'pylir-optimize' is configurable.
+// 'callee' costs more than the call to it, but less than 100.
+
+// NONE: (S) 0 Calls inlined
+// INLINE: (S) 1 Calls inlined
+
+py.func @callee(%arg0 : i32, %arg1 : i32) -> i32 {
+    %0 = arith.muli %arg0, %arg1 : i32
+    %1 = arith.muli %0, %arg1 : i32
+    %2 = arith.muli %1, %arg1 : i32
+    %3 = arith.muli %2, %arg1 : i32
+    %4 = arith.muli %3, %arg1 : i32
+    %5 = arith.muli %4, %arg1 : i32
+    %6 = arith.muli %5, %arg1 : i32
+    %7 = arith.muli %6, %arg1 : i32
+    %8 = arith.muli %7, %arg1 : i32
+    %9 = arith.muli %8, %arg1 : i32
+    return %9 : i32
+}
+
+py.func @test(%arg0 : i32, %arg1 : i32) -> i32 {
+    %0 = call @callee(%arg0, %arg1) : (i32, i32) -> i32
+    return %0 : i32
+}
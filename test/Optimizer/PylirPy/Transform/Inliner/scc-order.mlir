@@ -0,0 +1,35 @@
+// RUN: pylir-opt %s --pylir-inliner='threshold=0 function-pipeline=any(canonicalize) max-inlining-iterations=1' | FileCheck %s
+
+// SCCs are processed callees first. 'c' is therefore inlined into 'b', and 'b'
+// is simplified by the function pipeline, before any callsite of 'b' is graded.
+// The dead operations in 'b' would otherwise make it too expensive to inline
+// into 'a'.
+
+py.func @c(%arg0 : i32) -> i32 {
+    return %arg0 : i32
+}
+
+py.func @b(%arg0 : i32) -> i32 {
+    %0 = arith.muli %arg0, %arg0 : i32
+    %1 = arith.muli %0, %arg0 : i32
+    %2 = arith.muli %1, %arg0 : i32
+    %3 = arith.muli %2, %arg0 : i32
+    %4 = arith.muli %3, %arg0 : i32
+    %5 = arith.muli %4, %arg0 : i32
+    %6 = arith.muli %5, %arg0 : i32
+    %7 = call @c(%arg0) : (i32) -> i32
+    return %7 : i32
+}
+
+py.func @a(%arg0 : i32) -> i32 {
+    %0 = call @b(%arg0) : (i32) -> i32
+    return %0 : i32
+}
+
+// CHECK-LABEL: py.func @b
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: return %[[ARG0]]
+
+// CHECK-LABEL: py.func @a
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-NEXT: return %[[ARG0]]
@@ -0,0 +1,131 @@
+// RUN: pylir-opt %s --pylir-loop-int-unboxing --split-input-file | FileCheck %s
+
+#builtins_int = #py.globalValue<builtins.int, initializer = #py.type>
+py.external @builtins.int, #builtins_int
+
+py.func @sum(%n : !py.dynamic {py.type = #builtins_int}) -> !py.dynamic {
+  %0 = constant(#py.int<0>)
+  %1 = constant(#py.int<1>)
+  cf.br ^bb1(%0, %0 : !py.dynamic, !py.dynamic)
+
+^bb1(%i : !py.dynamic, %acc : !py.dynamic):
+  %2 = int_cmp lt %i, %n
+  cf.cond_br %2, ^bb2, ^bb3
+
+^bb2:
+  %3 = int_add %acc, %i
+  %4 = int_add %i, %1
+  cf.br ^bb1(%4, %3 : !py.dynamic, !py.dynamic)
+
+^bb3:
+  return %acc : !py.dynamic
+}
+
+// CHECK-LABEL: py.func @sum
+// CHECK-SAME: %[[N:[[:alnum:]]+]]
+// CHECK: %[[ZERO:.*]] = constant(#py.int<0>)
+// CHECK: %[[ONE:.*]] = constant(#py.int<1>)
+// CHECK: cf.br ^[[ENTRY:[[:alnum:]]+]]
+
+// The original loop is kept as slow path.
+// CHECK: ^[[HEADER:.*]](%[[I:.*]]: !py.dynamic, %[[ACC:.*]]: !py.dynamic):
+// CHECK-NEXT: %[[CMP:.*]] = int_cmp lt %[[I]], %[[N]]
+// CHECK-NEXT: cf.cond_br %[[CMP]], ^[[BODY:.*]], ^[[EXIT:.*]](%[[ACC]] : !py.dynamic)
+// CHECK: ^[[BODY]]:
+// CHECK-NEXT: %[[ADD1:.*]] = int_add %[[ACC]], %[[I]]
+// CHECK-NEXT: %[[ADD2:.*]] = int_add %[[I]], %[[ONE]]
+// CHECK-NEXT: cf.br ^[[HEADER]](%[[ADD2]], %[[ADD1]] : !py.dynamic, !py.dynamic)
+
+// Values leaving the fast loop are boxed.
+// CHECK: ^[[EXIT_EDGE:[[:alnum:]]+]]:
+// CHECK-NEXT: %[[BOXED:.*]] = int_fromSigned %[[FAST_ACC:[[:alnum:]]+]]
+// CHECK-NEXT: cf.br ^[[EXIT]](%[[BOXED]] : !py.dynamic)
+
+// CHECK: ^[[EXIT]](%[[RESULT:.*]]: !py.dynamic):
+// CHECK-NEXT: return %[[RESULT]]
+
+// The fast loop is only entered if all integers entering it fit into an index.
+// CHECK: ^[[ENTRY]]:
+// CHECK-NEXT: %[[ONE_INDEX:.*]], %[[ONE_VALID:.*]] = int_tryToIndex %[[ONE]]
+// CHECK-NEXT: %[[N_INDEX:.*]], %[[N_VALID:.*]] = int_tryToIndex %[[N]]
+// CHECK-NEXT: %[[ZERO_INDEX:.*]], %[[ZERO_VALID:.*]] = int_tryToIndex %[[ZERO]]
+// CHECK-NEXT: %[[AND:.*]] = arith.andi %[[ONE_VALID]], %[[N_VALID]]
+// CHECK-NEXT: %[[VALID:.*]] = arith.andi %[[AND]], %[[ZERO_VALID]]
+// CHECK-NEXT: cf.cond_br %[[VALID]], ^[[FAST_HEADER:.*]](%[[ZERO_INDEX]], %[[ZERO_INDEX]] : index, index), ^[[HEADER]](%[[ZERO]], %[[ZERO]] : !py.dynamic, !py.dynamic)
+
+// CHECK: ^[[FAST_HEADER]](%[[FAST_I:.*]]: index, %[[FAST_ACC]]: index):
+// CHECK-NEXT: %[[FAST_CMP:.*]] = arith.cmpi slt, %[[FAST_I]], %[[N_INDEX]]
+// CHECK-NEXT: cf.cond_br %[[FAST_CMP]], ^[[FAST_BODY:.*]], ^[[EXIT_EDGE]]
+
+// Additions branch to the slow loop on overflow.
+// CHECK: ^[[FAST_BODY]]:
+// CHECK-NEXT: %[[SUM1:.*]] = arith.addi %[[FAST_ACC]], %[[FAST_I]]
+// CHECK: %[[OVERFLOW1:.*]] = arith.cmpi slt
+// CHECK-NEXT: cf.cond_br %[[OVERFLOW1]], ^[[DEOPT:[[:alnum:]]+]], ^[[CONT:[[:alnum:]]+]]
+// CHECK: ^[[CONT]]:
+// CHECK-NEXT: %[[SUM2:.*]] = arith.addi %[[FAST_I]], %[[ONE_INDEX]]
+// CHECK: %[[OVERFLOW2:.*]] = arith.cmpi slt
+// CHECK-NEXT: cf.cond_br %[[OVERFLOW2]], ^[[DEOPT]], ^[[CONT2:[[:alnum:]]+]]
+// CHECK: ^[[CONT2]]:
+// CHECK-NEXT: cf.br ^[[FAST_HEADER]](%[[SUM2]], %[[SUM1]] : index, index)
+
+// The current iteration is restarted in the slow loop.
+// CHECK: ^[[DEOPT]]:
+// CHECK-NEXT: %[[BOXED_I:.*]] = int_fromSigned %[[FAST_I]]
+// CHECK-NEXT: %[[BOXED_ACC:.*]] = int_fromSigned %[[FAST_ACC]]
+// CHECK-NEXT: cf.br ^[[HEADER]](%[[BOXED_I]], %[[BOXED_ACC]] : !py.dynamic, !py.dynamic)
+
+// -----
+
+#builtins_int = #py.globalValue<builtins.int, initializer = #py.type>
+py.external @builtins.int, #builtins_int
+
+py.func private @sideEffect()
+
+// Loops with side effects can't be restarted and are not versioned.
+
+// CHECK-LABEL: py.func @side_effect
+// CHECK-NOT: int_tryToIndex
+// CHECK-NOT: arith.addi
+// CHECK: return
+py.func @side_effect(%n : !py.dynamic {py.type = #builtins_int}) {
+  %0 = constant(#py.int<0>)
+  %1 = constant(#py.int<1>)
+  cf.br ^bb1(%0 : !py.dynamic)
+
+^bb1(%i : !py.dynamic):
+  %2 = int_cmp lt %i, %n
+  cf.cond_br %2, ^bb2, ^bb3
+
+^bb2:
+  call @sideEffect() : () -> ()
+  %3 = int_add %i, %1
+  cf.br ^bb1(%3 : !py.dynamic)
+
+^bb3:
+  return
+}
+
+// -----
+
+// Values whose type is not known to be an integer can't be unboxed.
+
+// CHECK-LABEL: py.func @unknown
+// CHECK-NOT: int_tryToIndex
+// CHECK-NOT: arith.addi
+// CHECK: return
+py.func @unknown(%n : !py.dynamic, %start : !py.dynamic) {
+  %0 = constant(#py.int<1>)
+  cf.br ^bb1(%start : !py.dynamic)
+
+^bb1(%i : !py.dynamic):
+  %1 = int_cmp lt %i, %n
+  cf.cond_br %1, ^bb2, ^bb3
+
+^bb2:
+  %2 = int_add %i, %0
+  cf.br ^bb1(%2 : !py.dynamic)
+
+^bb3:
+  return
+}
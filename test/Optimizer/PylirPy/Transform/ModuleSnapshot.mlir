@@ -0,0 +1,121 @@
+// RUN: pylir-opt %s --pylir-module-snapshot --split-input-file | FileCheck %s
+
+// CHECK-DAG: #[[$FUNC:.*]] = #py.globalValue<{{.*}}, initializer = #py.function<@func>>
+// CHECK-DAG: #[[$DICT:.*]] = #py.globalValue<__main__$dict, initializer = #py.dict<{#py.str<"x"> to #py.int<5>, #py.str<"func"> to #[[$FUNC]]}>>
+
+#dict = #py.globalValue<__main__$dict, initializer = #py.dict<{}>>
+
+py.func @builtins.__init__() {
+  return
+}
+
+py.func @func() {
+  return
+}
+
+py.func private @unknown()
+
+py.func @__init__() {
+  call @builtins.__init__() : () -> ()
+  %0 = constant(#dict)
+  %1 = constant(#py.str<"x">)
+  %2 = str_hash %1
+  %3 = constant(#py.int<5>)
+  dict_setItem %0[%1 hash(%2)] to %3
+  %4 = makeFunc @func
+  %5 = constant(#py.str<"func">)
+  %6 = str_hash %5
+  dict_setItem %0[%5 hash(%6)] to %4
+  call @unknown() : () -> ()
+  %7 = constant(#py.str<"y">)
+  %8 = str_hash %7
+  dict_setItem %0[%7 hash(%8)] to %3
+  return
+}
+
+// CHECK-LABEL: py.func @__init__
+// CHECK-NEXT: call @builtins.__init__()
+// CHECK-NOT: dict_setItem
+// CHECK-NOT: makeFunc
+// CHECK: call @unknown()
+// CHECK: dict_setItem
+// CHECK-NEXT: return
+
+// -----
+
+// CHECK: #[[$DICT:.*]] = #py.globalValue<foo$dict, initializer = #py.dict<{#py.str<"x"> to #py.int<5>}>>
+
+#dict = #py.globalValue<foo$dict, initializer = #py.dict<{}>>
+
+py.global "private" @foo.__init__$initialized : index = 0 : index
+
+py.global "private" @value : !py.dynamic
+
+py.func @foo.__init__() {
+  %0 = load @foo.__init__$initialized : index
+  %1 = arith.constant 0 : index
+  %2 = arith.cmpi ne, %0, %1 : index
+  cf.cond_br %2, ^bb1, ^bb2
+
+^bb1:
+  return
+
+^bb2:
+  %3 = arith.constant 1 : index
+  store %3 : index into @foo.__init__$initialized
+  cf.br ^bb3
+
+^bb3:
+  %4 = constant(#dict)
+  %5 = constant(#py.str<"x">)
+  %6 = str_hash %5
+  %7 = constant(#py.int<5>)
+  dict_setItem %4[%5 hash(%6)] to %7
+  store %7 : !py.dynamic into @value
+  return
+}
+
+// CHECK: py.global "private" @foo.__init__$initialized : index = 0 : index
+// CHECK: py.global "private" @value : !py.dynamic = #py.int<5>
+
+// CHECK-LABEL: py.func @foo.__init__
+// CHECK: load @foo.__init__$initialized
+// CHECK: store %{{.*}} : index into @foo.__init__$initialized
+// CHECK-NOT: dict_setItem
+// CHECK-NOT: store
+// CHECK: return
+
+// -----
+
+#dict = #py.globalValue<foo$dict, initializer = #py.dict<{}>>
+
+py.global "private" @foo.__init__$initialized : index = 0 : index
+
+py.func @bar.__init__() {
+  call @foo.__init__() : () -> ()
+  return
+}
+
+py.func @__init__() {
+  call @foo.__init__() : () -> ()
+  return
+}
+
+py.func @foo.__init__() {
+  %c1 = arith.constant 1 : index
+  store %c1 : index into @foo.__init__$initialized
+  call @bar.__init__() : () -> ()
+  %0 = constant(#dict)
+  %1 = constant(#py.str<"x">)
+  %2 = str_hash %1
+  %3 = constant(#py.int<5>)
+  dict_setItem %0[%1 hash(%2)] to %3
+  return
+}
+
+// 'bar' may observe the partially initialized 'foo' module in a circular import.
+
+// CHECK-LABEL: py.func @foo.__init__
+// CHECK: call @bar.__init__()
+// CHECK-NEXT: constant
+// CHECK: dict_setItem
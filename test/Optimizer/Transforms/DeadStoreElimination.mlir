@@ -0,0 +1,160 @@
+// RUN: pylir-opt %s -pass-pipeline='builtin.module(any(pylir-dse))' --split-input-file | FileCheck %s
+
+py.func @test_overwritten(%arg0 : !py.dynamic) {
+    %0 = constant(#py.str<"first">)
+    %1 = constant(#py.str<"second">)
+    %c0 = arith.constant 0 : index
+    setSlot %arg0[%c0] to %0
+    setSlot %arg0[%c0] to %1
+    return
+}
+
+// CHECK-LABEL: py.func @test_overwritten
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[FIRST:.*]] = constant(#py.str<"first">)
+// CHECK: %[[SECOND:.*]] = constant(#py.str<"second">)
+// CHECK-NOT: setSlot %{{.*}} to %[[FIRST]]
+// CHECK: setSlot %[[ARG0]][%{{.*}}] to %[[SECOND]]
+// CHECK-NEXT: return
+
+// -----
+
+py.func @test_read(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = constant(#py.str<"first">)
+    %1 = constant(#py.str<"second">)
+    %c0 = arith.constant 0 : index
+    setSlot %arg0[%c0] to %0
+    %2 = getSlot %arg0[%c0]
+    setSlot %arg0[%c0] to %1
+    return %2 : !py.dynamic
+}
+
+// CHECK-LABEL: py.func @test_read
+// CHECK: setSlot
+// CHECK-NEXT: getSlot
+// CHECK-NEXT: setSlot
+
+// -----
+
+py.func @test_different_key(%arg0 : !py.dynamic) {
+    %0 = constant(#py.str<"first">)
+    %1 = constant(#py.str<"second">)
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    list_setItem %arg0[%c0] to %0
+    list_setItem %arg0[%c1] to %1
+    list_setItem %arg0[%c0] to %1
+    return
+}
+
+// Writes to the same aggregate in between are treated conservatively.
+
+// CHECK-LABEL: py.func @test_different_key
+// CHECK-COUNT-3: list_setItem
+
+// -----
+
+py.func private @bar()
+
+py.func @test_call(%arg0 : !py.dynamic) {
+    %0 = constant(#py.str<"first">)
+    %1 = constant(#py.str<"second">)
+    %c0 = arith.constant 0 : index
+    setSlot %arg0[%c0] to %0
+    call @bar() : () -> ()
+    setSlot %arg0[%c0] to %1
+    return
+}
+
+// CHECK-LABEL: py.func @test_call
+// CHECK: setSlot
+// CHECK-NEXT: call @bar
+// CHECK-NEXT: setSlot
+
+// -----
+
+py.global @foo : !py.dynamic
+
+py.func @test_global(%arg0 : !py.dynamic, %arg1 : !py.dynamic) {
+    store %arg0 : !py.dynamic into @foo
+    store %arg1 : !py.dynamic into @foo
+    return
+}
+
+// CHECK-LABEL: py.func @test_global
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-SAME: %[[ARG1:[[:alnum:]]+]]
+// CHECK-NOT: store %[[ARG0]]
+// CHECK: store %[[ARG1]] : !py.dynamic into @foo
+// CHECK-NEXT: return
+
+// -----
+
+#builtins_type = #py.globalValue<builtins.type, initializer = #py.type>
+
+py.func @test_unread_object(%arg0 : !py.dynamic) -> !py.dynamic {
+    %0 = constant(#builtins_type)
+    %1 = makeObject %0
+    %c0 = arith.constant 0 : index
+    setSlot %1[%c0] to %arg0
+    %2 = makeObject %0
+    setSlot %2[%c0] to %arg0
+    return %2 : !py.dynamic
+}
+
+// Stores to objects allocated within the function that are neither read nor
+// escape are dead.
+
+// CHECK-LABEL: py.func @test_unread_object
+// CHECK: %[[OBJ1:.*]] = makeObject
+// CHECK-NOT: setSlot %[[OBJ1]]
+// CHECK: %[[OBJ2:.*]] = makeObject
+// CHECK-NEXT: setSlot %[[OBJ2]]
+// CHECK-NEXT: return %[[OBJ2]]
+
+// -----
+
+py.func @test_overwritten_one_branch(%arg0 : !py.dynamic, %arg1 : i1) {
+    %0 = constant(#py.str<"first">)
+    %1 = constant(#py.str<"second">)
+    %c0 = arith.constant 0 : index
+    setSlot %arg0[%c0] to %0
+    cf.cond_br %arg1, ^bb1, ^bb2
+
+^bb1:
+    setSlot %arg0[%c0] to %1
+    return
+
+^bb2:
+    return
+}
+
+// The store is visible to the caller if '^bb2' is taken.
+
+// CHECK-LABEL: py.func @test_overwritten_one_branch
+// CHECK: %[[FIRST:.*]] = constant(#py.str<"first">)
+// CHECK: setSlot %{{.*}} to %[[FIRST]]
+// CHECK-NEXT: cf.cond_br
+
+// -----
+
+py.func @test_overwritten_both_branches(%arg0 : !py.dynamic, %arg1 : i1) {
+    %0 = constant(#py.str<"first">)
+    %1 = constant(#py.str<"second">)
+    %c0 = arith.constant 0 : index
+    setSlot %arg0[%c0] to %0
+    cf.cond_br %arg1, ^bb1, ^bb2
+
+^bb1:
+    setSlot %arg0[%c0] to %1
+    return
+
+^bb2:
+    setSlot %arg0[%c0] to %1
+    return
+}
+
+// CHECK-LABEL: py.func @test_overwritten_both_branches
+// CHECK: %[[FIRST:.*]] = constant(#py.str<"first">)
+// CHECK-NOT: setSlot %{{.*}} to %[[FIRST]]
+// CHECK: cf.cond_br
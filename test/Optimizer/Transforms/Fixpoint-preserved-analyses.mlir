@@ -0,0 +1,16 @@
+// RUN: pylir-opt %s -pass-pipeline='builtin.module(any(pylir-fixpoint{optimization-pipeline=pylir-canonicalize max-iteration-count=3}))' -mlir-pass-statistics 2>&1 | FileCheck %s
+
+// The first iteration simplifies the function. The second leaves it unchanged,
+// which 'pylir-canonicalize' reports by preserving all analyses.
+// CHECK: (S) 1 Fixpoints detected through preserved analyses
+// CHECK: (S) 0 Max iterations reached
+
+py.func @test(%value : !py.dynamic) -> !py.dynamic {
+    %0 = bool_toI1 %value
+    %1 = bool_fromI1 %0
+    return %1 : !py.dynamic
+}
+
+// CHECK-LABEL: py.func @test
+// CHECK-SAME: %[[VALUE:[[:alnum:]]+]]
+// CHECK-NEXT: return %[[VALUE]]
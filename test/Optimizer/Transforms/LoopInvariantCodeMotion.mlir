@@ -0,0 +1,95 @@
+// RUN: pylir-opt %s -pass-pipeline='builtin.module(any(pylir-licm))' --split-input-file | FileCheck %s
+
+py.global @foo : !py.dynamic
+
+py.func @test_hoist(%arg0 : !py.dynamic, %l : !py.dynamic, %n : index) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    cf.br ^bb1(%c0 : index)
+
+^bb1(%i : index):
+    %0 = typeOf %arg0
+    %1 = load @foo : !py.dynamic
+    %2 = tuple_len %1
+    list_setItem %l[%c0] to %0
+    %3 = arith.addi %i, %2 : index
+    %4 = arith.cmpi slt, %3, %n : index
+    cf.cond_br %4, ^bb1(%3 : index), ^bb2
+
+^bb2:
+    return
+}
+
+// CHECK-LABEL: py.func @test_hoist
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK: %[[TYPE:.*]] = typeOf %[[ARG0]]
+// CHECK-NEXT: %[[LOAD:.*]] = load @foo
+// CHECK-NEXT: %[[LEN:.*]] = tuple_len %[[LOAD]]
+// CHECK-NEXT: cf.br ^[[LOOP:[[:alnum:]]+]]
+// CHECK: ^[[LOOP]]
+// CHECK-NEXT: list_setItem %{{.*}}[%{{.*}}] to %[[TYPE]]
+// CHECK-NEXT: arith.addi %{{.*}}, %[[LEN]]
+
+// -----
+
+py.global @foo : !py.dynamic
+
+// Loads clobbered within the loop must not be hoisted.
+
+py.func @test_clobbered(%arg0 : !py.dynamic, %n : index) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    cf.br ^bb1(%c0 : index)
+
+^bb1(%i : index):
+    %0 = load @foo : !py.dynamic
+    store %arg0 : !py.dynamic into @foo
+    %1 = arith.addi %i, %c1 : index
+    %2 = arith.cmpi slt, %1, %n : index
+    cf.cond_br %2, ^bb1(%1 : index), ^bb2
+
+^bb2:
+    return
+}
+
+// CHECK-LABEL: py.func @test_clobbered
+// CHECK: cf.br ^[[LOOP:[[:alnum:]]+]]
+// CHECK: ^[[LOOP]]
+// CHECK-NEXT: load @foo
+// CHECK-NEXT: store
+
+// -----
+
+// Operations that may not execute on every iteration are only hoisted if they
+// are speculatable.
+
+py.func @test_conditional(%arg0 : !py.dynamic, %n : index, %cond : i1) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    cf.br ^bb1(%c0 : index)
+
+^bb1(%i : index):
+    %0 = arith.addi %i, %c1 : index
+    %1 = arith.cmpi slt, %0, %n : index
+    cf.cond_br %1, ^bb2, ^bb4
+
+^bb2:
+    cf.cond_br %cond, ^bb3, ^bb1(%0 : index)
+
+^bb3:
+    %2 = tuple_len %arg0
+    %3 = arith.muli %n, %c1 : index
+    test.use(%2) : index
+    test.use(%3) : index
+    cf.br ^bb1(%0 : index)
+
+^bb4:
+    return
+}
+
+// CHECK-LABEL: py.func @test_conditional
+// CHECK: %[[MUL:.*]] = arith.muli
+// CHECK-NEXT: cf.br ^[[LOOP:[[:alnum:]]+]]
+// CHECK: tuple_len
+// CHECK-NEXT: test.use
+// CHECK-NEXT: test.use(%[[MUL]])
@@ -0,0 +1,40 @@
+// RUN: pylir-opt -pass-pipeline="builtin.module(any(pylir-sroa))" %s --split-input-file | FileCheck %s
+
+py.func @test(%arg0 : !py.dynamic) -> (!py.dynamic, index) {
+    %0 = constant(#py.str<"Hello">)
+    %t = makeTuple (%0, %arg0)
+    %zero = arith.constant 0 : index
+    %one = arith.constant 1 : index
+    %1 = tuple_getItem %t[%zero]
+    %2 = tuple_getItem %t[%one]
+    %3 = str_concat %1, %2
+    %4 = tuple_len %t
+    return %3, %4 : !py.dynamic, index
+}
+
+// CHECK-LABEL: py.func @test
+// CHECK-SAME: %[[ARG0:[[:alnum:]]+]]
+// CHECK-DAG: %[[H:.*]] = constant(#py.str<"Hello">)
+// CHECK-DAG: %[[L:.*]] = arith.constant 2
+// CHECK-NOT: makeTuple
+// CHECK: %[[R:.*]] = str_concat %[[H]], %[[ARG0]]
+// CHECK: return %[[R]], %[[L]]
+
+// -----
+
+// Tuples escaping or created with iterator expansion can't be replaced.
+
+py.func @test(%arg0 : !py.dynamic) -> (!py.dynamic, !py.dynamic) {
+    %zero = arith.constant 0 : index
+    %t = makeTuple (%arg0)
+    %0 = tuple_getItem %t[%zero]
+    %e = makeTuple (* %arg0)
+    %1 = tuple_getItem %e[%zero]
+    return %0, %t : !py.dynamic, !py.dynamic
+}
+
+// CHECK-LABEL: py.func @test
+// CHECK: %[[T:.*]] = makeTuple
+// CHECK: tuple_getItem %[[T]]
+// CHECK: %[[E:.*]] = makeTuple (* %
+// CHECK: tuple_getItem %[[E]]
@@ -3,6 +3,7 @@
 //  SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/Dominance.h>
 #include <mlir/Interfaces/FunctionInterfaces.h>
 #include <mlir/Pass/Pass.h>
 
@@ -11,6 +12,7 @@
 #include <pylir/Optimizer/Analysis/MemorySSA.hpp>
 
 #include <memory>
+#include <optional>
 
 #include "Passes.hpp"
 
@@ -23,6 +25,10 @@ namespace {
 
 class TestMemorySSA
     : public pylir::test::impl::TestMemorySSAPassBase<TestMemorySSA> {
+  void reinsertMemoryAccesses(pylir::MemorySSA& memorySSA,
+                              mlir::DominanceInfo& dominanceInfo,
+                              mlir::Operation* op);
+
 protected:
   void runOnOperation() override;
 
@@ -32,7 +38,72 @@ public:
 
 void TestMemorySSA::runOnOperation() {
   for (auto func : getOperation().getOps<mlir::FunctionOpInterface>()) {
-    llvm::outs() << getChildAnalysis<pylir::MemorySSA>(func);
+    auto& memorySSA = getChildAnalysis<pylir::MemorySSA>(func);
+    if (!m_removeOp.empty()) {
+      func->walk([&](mlir::Operation* op) {
+        if (op->getName().getStringRef() != m_removeOp || !op->use_empty())
+          return;
+
+        memorySSA.removeMemoryAccesses(op);
+        op->erase();
+      });
+    }
+    if (!m_reinsertOp.empty()) {
+      auto& dominanceInfo = getChildAnalysis<mlir::DominanceInfo>(func);
+      func->walk([&](mlir::Operation* op) {
+        if (op->getName().getStringRef() == m_reinsertOp)
+          reinsertMemoryAccesses(memorySSA, dominanceInfo, op);
+      });
+    }
+    llvm::outs() << memorySSA;
+  }
+}
+
+void TestMemorySSA::reinsertMemoryAccesses(pylir::MemorySSA& memorySSA,
+                                           mlir::DominanceInfo& dominanceInfo,
+                                           mlir::Operation* op) {
+  using Locations =
+      llvm::ArrayRef<llvm::PointerUnion<mlir::Value, mlir::SymbolRefAttr>>;
+  struct Access {
+    bool isDef;
+    mlir::Value definition;
+    /// Index of the access of 'op' that 'definition' is the result of.
+    std::optional<std::size_t> definingAccess;
+    Locations writes;
+    Locations reads;
+  };
+
+  llvm::ArrayRef<mlir::Operation*> oldAccesses =
+      memorySSA.getMemoryAccesses(op);
+  llvm::SmallVector<Access> accesses;
+  for (mlir::Operation* access : oldAccesses) {
+    Access& copy = accesses.emplace_back();
+    llvm::TypeSwitch<mlir::Operation*>(access)
+        .Case([&](pylir::MemSSA::MemoryUseOp use) {
+          copy = {false, use.getDefinition(), std::nullopt, {}, use.getReads()};
+        })
+        .Case([&](pylir::MemSSA::MemoryDefOp def) {
+          copy = {true, def.getClobbered(), std::nullopt, def.getWrites(),
+                  def.getReads()};
+        });
+    const auto* iter = llvm::find(oldAccesses, copy.definition.getDefiningOp());
+    if (iter != oldAccesses.end())
+      copy.definingAccess = iter - oldAccesses.begin();
+  }
+
+  memorySSA.removeMemoryAccesses(op);
+  llvm::SmallVector<mlir::Value> newResults;
+  for (const Access& access : accesses) {
+    mlir::Value definition = access.definingAccess
+                                 ? newResults[*access.definingAccess]
+                                 : access.definition;
+    if (!access.isDef) {
+      memorySSA.createMemoryUse(op, definition, access.reads);
+      newResults.emplace_back();
+      continue;
+    }
+    newResults.push_back(memorySSA.createMemoryDef(
+        op, definition, access.writes, access.reads, dominanceInfo));
   }
 }
 } // namespace
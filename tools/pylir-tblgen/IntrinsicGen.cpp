@@ -20,6 +20,7 @@ bool typeIsCompatible(const mlir::tblgen::TypeConstraint& type) {
   return llvm::StringSwitch<bool>(defName)
       .Case("I1", true)
       .Case("Index", true)
+      .Case("SignedIndex", true)
       .Case("DynamicType", true)
       .Default(false);
 }
@@ -65,6 +66,10 @@ genOutputTypeConversion(std::string inputValue,
     return llvm::formatv(
         "m_builder.create<::pylir::Py::IntFromUnsignedOp>({0})", inputValue);
   }
+  if (fromType.getDefName() == "SignedIndex") {
+    return llvm::formatv("m_builder.create<::pylir::Py::IntFromSignedOp>({0})",
+                         inputValue);
+  }
   assert(fromType.getDefName() == "I1");
   return llvm::formatv("m_builder.create<::pylir::Py::BoolFromI1Op>({0})",
                        inputValue);
@@ -75,7 +80,8 @@ std::string genInputTypeConversion(std::string inputValue,
   if (toType.getDefName() == "DynamicType") {
     return inputValue;
   }
-  if (toType.getDefName() == "Index") {
+  if (toType.getDefName() == "Index" ||
+      toType.getDefName() == "SignedIndex") {
     return llvm::formatv("m_builder.create<::pylir::Py::IntToIndexOp>({0})",
                          inputValue);
   }
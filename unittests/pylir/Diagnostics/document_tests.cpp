@@ -30,14 +30,14 @@ TEST_CASE("Document BOM detection", "[Document]") {
                       "\x00\x00\x74\x00\x00\x00",
                       20};
     pylir::Diag::Document document(bytes);
-    CHECK(document.getText() == U"Text");
+    CHECK(document.getText() == "Text");
   }
   SECTION("UTF32BE BOM") {
     std::string bytes{"\x00\x00\xFE\xFF\x00\x00\x00\x54\x00\x00\x00\x65\x00\x00"
                       "\x00\x78\x00\x00\x00\x74",
                       20};
     pylir::Diag::Document document(bytes);
-    CHECK(document.getText() == U"Text");
+    CHECK(document.getText() == "Text");
   }
 }
 
@@ -45,5 +45,52 @@ TEST_CASE("Document line normalization", "[Document]") {
   pylir::Diag::Document document("Windows\r\n"
                                  "Unix\n"
                                  "OldMac\r");
-  CHECK(document.getText() == U"Windows\nUnix\nOldMac\n");
+  CHECK(document.getText() == "Windows\nUnix\nOldMac\n");
+}
+
+TEST_CASE("Document UTF8 decoding", "[Document]") {
+  SECTION("Mixed ASCII and non-ASCII") {
+    pylir::Diag::Document document("long ascii prefix \xC3\xA4\xE2\x82\xAC "
+                                   "long ascii suffix\xF0\x9F\x98\x80");
+    CHECK(document.getText() == "long ascii prefix \xC3\xA4\xE2\x82\xAC "
+                                "long ascii suffix\xF0\x9F\x98\x80");
+    std::u32string text(document.begin(), document.end());
+    CHECK(text == U"long ascii prefix ä€ long ascii suffix\U0001F600");
+  }
+  SECTION("Line starts") {
+    pylir::Diag::Document document("first line\r\nsecond line\rthird\n"
+                                   "\xC3\xA4");
+    CHECK(document.getText() == "first line\nsecond line\nthird\n\xC3\xA4");
+    CHECK(document.getLineNumber(0) == 1);
+    CHECK(document.getLineNumber(11) == 2);
+    CHECK(document.getLine(2) == "second line");
+    CHECK(document.getLine(3) == "third");
+    CHECK(document.getLine(4) == "\xC3\xA4");
+  }
+}
+
+TEST_CASE("Document UTF8 storage", "[Document]") {
+  SECTION("Ill-formed sequences") {
+    pylir::Diag::Document document("a\xFF"
+                                   "b");
+    CHECK(document.getText() == "a\xEF\xBF\xBD"
+                                "b");
+  }
+  SECTION("Iteration") {
+    pylir::Diag::Document document("a\xC3\xA4\xF0\x9F\x98\x80");
+    auto iter = std::next(document.begin());
+    CHECK(*iter == U'ä');
+    CHECK(iter - document.begin() == 1);
+    ++iter;
+    CHECK(*iter == U'\U0001F600');
+    CHECK(iter - document.begin() == 3);
+    CHECK(std::next(iter) == document.end());
+    --iter;
+    CHECK(*iter == U'ä');
+  }
+  SECTION("Columns are counted in codepoints") {
+    pylir::Diag::Document document("\xC3\xA4\xE2\x82\xAC x\nb");
+    CHECK(document.getLineCol(6) == std::pair<std::size_t, std::size_t>{1, 4});
+    CHECK(document.getLineCol(8) == std::pair<std::size_t, std::size_t>{2, 1});
+  }
 }
@@ -152,6 +152,22 @@ TEST_CASE("Lex identifiers", "[Lexer]") {
     REQUIRE(str);
     CHECK(*str == "KADOKAWA");
   }
+  SECTION("ASCII") {
+    pylir::Diag::Document document("_snake_Case9 Falsy iff");
+    auto docManager = manager.createSubDiagnosticManager(document);
+    pylir::Lexer lexer(docManager);
+    std::vector result(lexer.begin(), lexer.end());
+    REQUIRE(result.size() == 4);
+    std::vector<std::string> names;
+    result.pop_back();
+    for (auto& token : result) {
+      CHECK(token.getTokenType() == pylir::TokenType::Identifier);
+      const auto* str = std::get_if<std::string>(&token.getValue());
+      REQUIRE(str);
+      names.push_back(*str);
+    }
+    CHECK(names == std::vector<std::string>{"_snake_Case9", "Falsy", "iff"});
+  }
 }
 
 TEST_CASE("Lex keywords", "[Lexer]") {
@@ -945,3 +961,35 @@ TEST_CASE("Lexer fuzzer discoveries", "[Lexer]") {
   lex("0Y");
   lex("\xFF\xfe\xff");
 }
+
+TEST_CASE("Lexer discarding tokens", "[Lexer]") {
+  std::string error;
+  pylir::Diag::DiagnosticsManager manager(
+      [&error](pylir::Diag::Diagnostic&& base) {
+        llvm::raw_string_ostream(error) << base;
+      });
+  pylir::Diag::Document document("foo = 5\n"
+                                 "    bar\n"
+                                 "   foobar");
+  auto docManager = manager.createSubDiagnosticManager(document);
+
+  pylir::Lexer expectedLexer(docManager);
+  std::vector<pylir::TokenType> expected;
+  std::transform(expectedLexer.begin(), expectedLexer.end(),
+                 std::back_inserter(expected),
+                 [](const pylir::Token& token) { return token.getTokenType(); });
+  error.clear();
+
+  pylir::Lexer lexer(docManager);
+  std::vector<pylir::TokenType> result;
+  for (auto iter = lexer.begin(); iter != lexer.end(); iter++) {
+    lexer.discardTokensBefore(iter);
+    result.push_back(iter->getTokenType());
+  }
+  CHECK_THAT(result, Catch::Matchers::Equals(expected));
+  // Diagnostics referring to previous indentation must still be emitted
+  // after the indent token has been discarded.
+  CHECK_THAT(error,
+             Catch::Matchers::ContainsSubstring(
+                 fmt::format(pylir::Diag::NEXT_CLOSEST_INDENTATION_N, 4)));
+}
@@ -143,3 +143,45 @@ TEST_CASE("BigInt toRatio", "[BigInt]") {
   CHECK(num == pylir::BigInt(0));
   CHECK(denom == pylir::BigInt(1));
 }
+
+namespace {
+std::string toDecimalReference(const pylir::BigInt& integer) {
+  std::size_t size;
+  REQUIRE(mp_radix_size_overestimate(&integer.getHandle(), 10, &size) ==
+          MP_OKAY);
+  std::string result(size, '\0');
+  REQUIRE(mp_to_radix(&integer.getHandle(), result.data(), result.size(),
+                      &size, 10) == MP_OKAY);
+  result.resize(size - 1);
+  return result;
+}
+} // namespace
+
+TEST_CASE("BigInt toString decimal", "[BigInt]") {
+  auto value = GENERATE(
+      pylir::BigInt(0), pylir::BigInt(9), pylir::BigInt(-10),
+      pylir::BigInt(std::numeric_limits<std::uint64_t>::max()),
+      ++pylir::BigInt(std::numeric_limits<std::uint64_t>::max()),
+      -pylir::pow(pylir::BigInt(10), 19), pylir::pow(pylir::BigInt(10), 2000),
+      pylir::pow(pylir::BigInt(7), 5000), -pylir::pow(pylir::BigInt(3), 20000));
+  std::string result = value.toString();
+  CHECK(result == toDecimalReference(value));
+  CHECK(result.size() <= value.decimalSizeOverestimate());
+}
+
+TEST_CASE("BigInt hash", "[BigInt]") {
+  CHECK(pylir::BigInt(0).hash() == 0);
+  CHECK(pylir::BigInt(5).hash() == 5);
+  CHECK(pylir::BigInt(-5).hash() == static_cast<std::size_t>(-5));
+  // -1 is reserved.
+  CHECK(pylir::BigInt(-1).hash() == static_cast<std::size_t>(-2));
+  CHECK(pylir::BigInt(-2).hash() == static_cast<std::size_t>(-2));
+
+  unsigned hashBits = sizeof(std::size_t) == 8 ? 61 : 31;
+  pylir::BigInt modulus = (pylir::BigInt(1) << hashBits) - pylir::BigInt(1);
+  CHECK(modulus.hash() == 0);
+  CHECK((modulus + pylir::BigInt(1)).hash() == 1);
+  CHECK((pylir::BigInt(1) << (hashBits * 3 + 5)).hash() == 32);
+  CHECK((-(pylir::BigInt(1) << (hashBits * 3 + 5))).hash() ==
+        static_cast<std::size_t>(-32));
+}